@@ -0,0 +1,70 @@
+/*
+ * File: adc.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: ADC2 set-up, channel selection and threshold control (adc.h).
+ */
+
+#include <xc.h>
+#include <stdbool.h>
+#include "adc.h"
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Set up the computation and the trigger and switch the ADC on. Select the channel with
+// adc_select() before or after, the first conversion starts with the next trigger.
+void adc_init(const AdcConfig *config) {
+    ADCON0 = 0x00;                 // ADC off while configuring
+    ADCON1 = 0x00;
+    ADCON2 = config->adcon2;
+    ADCON3 = config->adcon3;
+    ADRPT = config->repeat;
+    ADREF = 0x00;                  // VDD and VSS references
+    ADPREL = 0x00;                 // No precharge
+    ADPREH = 0x00;
+    ADSTPTH = 0x00;                // Setpoint 0: ADERR is the reading itself
+    ADSTPTL = 0x00;
+
+    PIE1bits.ADIE = 0;             // Results come with the threshold interrupt
+    ADACT = config->trigger;       // Conversions start from the trigger instead of GO
+    ADCON0 = ADC_ADCON0;
+}
+
+// Convert a channel (ADPCH code) with an acquisition time in ADC clock periods, from the next
+// trigger on
+void adc_select(unsigned char channel, unsigned char acquisition) {
+    ADPCH = channel;
+    ADACQL = acquisition;
+    ADACQH = 0x00;
+}
+
+// Threshold levels the TMD mode compares ADERR against, in result counts
+void adc_set_thresholds(unsigned int upper, unsigned int lower) {
+    ADUTHH = (unsigned char)(upper >> 8);
+    ADUTHL = (unsigned char)upper;
+    ADLTHH = (unsigned char)(lower >> 8);
+    ADLTHL = (unsigned char)lower;
+}
+
+// Change ADCALC and the threshold interrupt mode, e.g. to test for the opposite crossing
+void adc_set_mode(unsigned char adcon3) {
+    ADCON3 = adcon3;
+}
+
+// Enable the threshold interrupt with its flag cleared, or disable it
+void adc_threshold_irq(bool on) {
+    PIE1bits.ADTIE = 0;
+    if (on) {
+        PIR1bits.ADTIF = 0;
+        PIE1bits.ADTIE = 1;
+    }
+}
+
+// Last filtered or burst-averaged result
+unsigned int adc_filtered(void) {
+    return ((unsigned int)ADFLTRH << 8) | ADFLTRL;
+}
@@ -0,0 +1,49 @@
+/*
+ * File: adc.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: ADC2 (computation ADC) set-up shared by the C projects. adc_init() runs the ADC on
+ *          its own ADCRC clock with right-justified results, VDD/VSS references and a setpoint of
+ *          0, so the threshold comparison works on the reading itself. An AdcConfig gives the
+ *          computation mode (ADCON2/ADCON3), the burst or accumulation length and the
+ *          auto-conversion trigger, so conversions start from a timer and results come with the
+ *          threshold interrupt instead of being polled.
+ *          Pins, channels, thresholds and the interrupt priority and routine stay in the project.
+ */
+
+#ifndef ADC_H
+#define ADC_H
+
+#include <xc.h>
+#include <stdbool.h>
+
+//=============================================================================
+// ADC DEFINITIONS
+//=============================================================================
+#define ADC_ADCON0          0x94    // ADC on, single conversion, ADCRC clock, right justified
+
+// ADACT auto-conversion trigger codes
+#define ADC_TRIGGER_NONE    0x00    // ADGO only
+#define ADC_TRIGGER_TMR0    0x02    // Timer0 overflow (the 1 ms tick)
+#define ADC_TRIGGER_TMR2    0x04    // Timer2 postscaler output
+
+typedef struct {
+    unsigned char adcon2;  // Computation mode and ADCRS
+    unsigned char adcon3;  // ADCALC and threshold interrupt mode (TMD)
+    unsigned char repeat;  // ADRPT, conversions per burst or accumulation
+    unsigned char trigger; // ADACT trigger code
+} AdcConfig;
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void adc_init(const AdcConfig *config);  // Set up and switch on the ADC
+void adc_select(unsigned char channel, unsigned char acquisition);  // Convert a channel from the next trigger on
+void adc_set_thresholds(unsigned int upper, unsigned int lower);  // Threshold levels (ADUTH, ADLTH)
+void adc_set_mode(unsigned char adcon3);  // Change ADCALC and the threshold interrupt mode
+void adc_threshold_irq(bool on);  // Enable or disable the threshold interrupt
+unsigned int adc_filtered(void);  // Last filtered or averaged result (ADFLTR)
+
+#endif /* ADC_H */
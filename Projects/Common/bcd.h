@@ -0,0 +1,84 @@
+/*
+ * File: bcd.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Fixed-cycle binary to decimal digit conversion for the C projects.
+ *          Division by 10 is a multiply by a reciprocal and a shift, so it runs on the
+ *          PIC18 hardware multiplier (MULWF) instead of the XC8 software division.
+ *          Digits are stored most significant first. Common/bcd.inc is the asm version.
+ */
+
+#ifndef BCD_H
+#define BCD_H
+
+#include <stdbool.h>
+
+//=============================================================================
+// DIVIDE BY 10
+//=============================================================================
+
+// x / 10 for 0-255: (x * 205) >> 11, one 8x8 multiply
+static inline unsigned char bcd_div10_u8(unsigned char x) {
+    return (unsigned char)(((unsigned int)x * 205u) >> 11);
+}
+
+// x / 10 for 0-65535: (x * 52429) >> 19, one 16x16 multiply (four MULWF partial products)
+static inline unsigned int bcd_div10_u16(unsigned int x) {
+    return (unsigned int)(((unsigned long)x * 52429UL) >> 19);
+}
+
+// x / 10 for any 32-bit x with shifts and adds (q ~ x * 0.8 / 8), then one correction step.
+// A 32x32 reciprocal multiply would need a 64-bit product. C only, no bcd.inc version.
+static inline unsigned long bcd_div10_u32(unsigned long x) {
+    unsigned long q = (x >> 1) + (x >> 2);
+    unsigned long r;
+
+    q += q >> 4;
+    q += q >> 8;
+    q += q >> 16;
+    q >>= 3;
+    r = x - ((q << 2) + q) * 2;    // Remainder of the estimate, 0 to 19
+    return q + (r > 9);
+}
+
+//=============================================================================
+// DIGIT CONVERSION
+//=============================================================================
+
+// 0-255 to 3 digits (hundreds, tens, units)
+static inline void bcd_from_u8(unsigned char x, unsigned char digits[3]) {
+    unsigned char q = bcd_div10_u8(x);
+    unsigned char h = bcd_div10_u8(q);
+
+    digits[2] = x - (unsigned char)(q * 10);
+    digits[1] = q - (unsigned char)(h * 10);
+    digits[0] = h;
+}
+
+// -128-127 to 3 digits of the magnitude, returns true if x is negative
+static inline bool bcd_from_s8(signed char x, unsigned char digits[3]) {
+    bcd_from_u8(x < 0 ? (unsigned char)-x : (unsigned char)x, digits);
+    return x < 0;
+}
+
+// 0-65535 to 5 digits (ten thousands ... units)
+static inline void bcd_from_u16(unsigned int x, unsigned char digits[5]) {
+    unsigned int q;
+
+    for (signed char i = 4; i > 0; i--) {  // Fixed 4 passes, the last quotient is the top digit
+        q = bcd_div10_u16(x);
+        digits[i] = (unsigned char)(x - q * 10);
+        x = q;
+    }
+    digits[0] = (unsigned char)x;
+}
+
+// -32768-32767 to 5 digits of the magnitude, returns true if x is negative
+static inline bool bcd_from_s16(int x, unsigned char digits[5]) {
+    bcd_from_u16(x < 0 ? 0u - (unsigned int)x : (unsigned int)x, digits);
+    return x < 0;
+}
+
+#endif /* BCD_H */
@@ -0,0 +1,121 @@
+/*
+ * File: buzzer.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Piezo buzzer PWM tone and sound queue (buzzer.h).
+ */
+
+#include <xc.h>
+#include <stdbool.h>
+#include "timer.h"
+#include "buzzer.h"
+
+//=============================================================================
+// DRIVER STATE
+//=============================================================================
+static const Note *buzzerQueue[BUZZER_QUEUE_SIZE];  // Pending sounds
+static volatile unsigned char buzzerHead = 0;       // Index of the next sound to play
+static volatile unsigned char buzzerCount = 0;      // Number of pending sounds
+static const Note * volatile buzzerNote = 0;        // Note playing, 0 when silent
+static volatile unsigned int buzzerLeft = 0;        // Milliseconds left of the current note
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Set up the PWM tone generator, silent. The caller routes CCP1 to the buzzer pin.
+void buzzer_init(void) {
+    buzzerHead = 0;
+    buzzerCount = 0;
+    buzzerNote = 0;
+    buzzerLeft = 0;
+
+    CCPTMRS0bits.C1TSEL = 1;    // CCP1 uses Timer2
+    CCPR1H = 0;                 // 0% duty (silent)
+    CCPR1L = 0;
+    CCP1CON = BUZZER_CCP1CON;
+
+    timer2_init(BUZZER_T2_CKPS, 0xFF);  // Tone timer, the period follows each note
+}
+
+// Queue a sound after the ones already pending. Returns immediately.
+void buzzer_play(const Note *notes) {
+    INTCON0bits.GIEL = 0;  // buzzer_tick() runs in the low priority interrupt
+    if (buzzerCount < BUZZER_QUEUE_SIZE) {  // Drop the sound if the queue is full
+        buzzerQueue[(buzzerHead + buzzerCount) & (BUZZER_QUEUE_SIZE - 1)] = notes;
+        buzzerCount++;
+    }
+    INTCON0bits.GIEL = 1;
+}
+
+// Drop pending sounds and start this one on the next tick
+void buzzer_play_now(const Note *notes) {
+    INTCON0bits.GIEL = 0;
+    buzzerHead = 0;
+    buzzerCount = 1;
+    buzzerQueue[0] = notes;
+    buzzerNote = 0;
+    buzzerLeft = 0;
+    buzzer_tone(NOTE_REST);
+    INTCON0bits.GIEL = 1;
+}
+
+// Drop pending sounds and silence the buzzer
+void buzzer_stop(void) {
+    INTCON0bits.GIEL = 0;
+    buzzerHead = 0;
+    buzzerCount = 0;
+    buzzerNote = 0;
+    buzzerLeft = 0;
+    buzzer_tone(NOTE_REST);
+    INTCON0bits.GIEL = 1;
+}
+
+// Check if a sound is playing or queued
+bool buzzer_busy(void) {
+    return (buzzerNote != 0) || (buzzerCount > 0);
+}
+
+// Set the PWM to a note period with 50% duty (NOTE_REST = off)
+void buzzer_tone(unsigned char period) {
+    unsigned int duty;
+
+    if (period == NOTE_REST) {
+        CCPR1H = 0;  // 0% duty holds the pin low
+        CCPR1L = 0;
+        return;
+    }
+    duty = ((unsigned int)period + 1) << 1;  // Half of the 10-bit PWM period, 4 * (T2PR + 1)
+    T2PR = period;
+    CCPR1H = (unsigned char)(duty >> 8);
+    CCPR1L = (unsigned char)duty;
+}
+
+// Step the current sound, called from the 1 ms tick interrupt
+void buzzer_tick(void) {
+    if (buzzerLeft > 1) {  // Current note still playing
+        buzzerLeft--;
+        return;
+    }
+
+    if (buzzerNote != 0) {
+        buzzerNote++;  // Note finished, move to the next one
+    } else if (buzzerCount > 0) {
+        buzzerNote = buzzerQueue[buzzerHead];  // Start the next queued sound
+        buzzerHead = (buzzerHead + 1) & (BUZZER_QUEUE_SIZE - 1);
+        buzzerCount--;
+    } else {
+        return;  // Nothing to play
+    }
+
+    if (buzzerNote->len == 0) {  // End of the table
+        buzzer_tone(NOTE_REST);
+        buzzerNote = 0;
+        buzzerLeft = 0;
+        return;
+    }
+    buzzer_tone(buzzerNote->period);
+    buzzerLeft = (unsigned int)buzzerNote->len * 10;
+}
@@ -0,0 +1,67 @@
+/*
+ * File: buzzer.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Piezo buzzer driver shared by the C projects. CCP1 generates the tone in PWM mode on
+ *          Timer2 (Common/timer.h). The project routes CCP1 to its buzzer pin with PPS
+ *          (RxyPPS = BUZZER_PPS_CCP1) and keeps that pin low until buzzer_init().
+ *          Sounds are const note tables stepped by buzzer_tick() from the 1 ms tick interrupt,
+ *          so starting a sound only queues it and returns. The tick must be the low priority
+ *          interrupt (IPEN = 1): the queue is guarded with GIEL, high priority ISRs keep running.
+ */
+
+#ifndef BUZZER_H
+#define BUZZER_H
+
+#include <xc.h>
+#include <stdbool.h>
+#include "clock.h"
+
+//=============================================================================
+// PWM DEFINITIONS
+//=============================================================================
+
+// Timer2 clock: Fosc/4 with the prescaler giving 62.5 kHz (125 kHz at 64 MHz, the prescaler
+// stops at 1:128), tone = BUZZER_TIMER_HZ / (T2PR + 1)
+#if CLOCK_TICK_CKPS + 2 > 7
+#define BUZZER_T2_CKPS      7
+#else
+#define BUZZER_T2_CKPS      (CLOCK_TICK_CKPS + 2)
+#endif
+#define BUZZER_TIMER_HZ     (FCY >> BUZZER_T2_CKPS)         // Timer2 count rate
+#define BUZZER_CCP1CON      0x8C    // CCP1 on, right-aligned, PWM mode
+#define BUZZER_PPS_CCP1     0x09    // RxyPPS output code for CCP1
+
+//=============================================================================
+// NOTE DEFINITIONS
+//=============================================================================
+
+// Note period for a frequency in Hz (BUZZER_TIMER_HZ / 256 to BUZZER_TIMER_HZ / 2)
+#define BUZZER_PERIOD(hz)   ((unsigned char)(BUZZER_TIMER_HZ / (hz) - 1))
+#define BUZZER_LEN(ms)      ((unsigned char)((ms) / 10))  // Note length in 10 ms units
+
+#define NOTE_REST           0       // Period 0 = silence
+#define NOTE_END            {NOTE_REST, 0}  // Length 0 ends a note table
+
+#define BUZZER_QUEUE_SIZE   4       // Pending sounds (power of two)
+
+// One note of a sound: 2 bytes in program memory
+typedef struct {
+    unsigned char period;  // T2PR value from BUZZER_PERIOD(), NOTE_REST for silence
+    unsigned char len;     // Length from BUZZER_LEN(), 0 ends the table
+} Note;
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void buzzer_init(void);  // Set up the PWM tone generator, silent
+void buzzer_play(const Note *notes);  // Queue a sound after the ones already pending
+void buzzer_play_now(const Note *notes);  // Drop pending sounds and start this one
+void buzzer_stop(void);  // Drop pending sounds and silence the buzzer
+bool buzzer_busy(void);  // Check if a sound is playing or queued
+void buzzer_tone(unsigned char period);  // Set the PWM to a note period (NOTE_REST = off)
+void buzzer_tick(void);  // Step the current sound, called from the 1 ms tick interrupt
+
+#endif /* BUZZER_H */
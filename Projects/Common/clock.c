@@ -0,0 +1,66 @@
+/*
+ * File: clock.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Clock profile switching and the clock-independent delay and baud helpers (clock.h).
+ *          The oscillator configuration bits are set here, once for the whole program.
+ */
+
+// CONFIG1L: no external oscillator, reset straight onto HFINTOSC (64 MHz, NDIV 1:1)
+#pragma config FEXTOSC = OFF             // External Oscillator Selection (Oscillator not enabled)
+#pragma config RSTOSC = HFINTOSC_64MHZ   // Reset Oscillator Selection (HFINTOSC with HFFRQ = 64 MHz and CDIV = 1:1)
+
+#include <xc.h>
+#include "clock.h"
+
+//=============================================================================
+// CLOCK STATE
+//=============================================================================
+static unsigned char clockProfile = CLOCK_PROFILE;  // Profile running now
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Switch to the start-up profile, call before anything that depends on the clock
+void clock_init(void) {
+    OSCFRQ = 0x08;                 // HFFRQ = 64 MHz
+    clock_switch(CLOCK_PROFILE);
+}
+
+// Change the system clock at run time. Fosc/4 clocked timers and the UART must be set up
+// again from clock_tick_ckps() and clock_uart_brg() afterwards.
+void clock_switch(unsigned char profile) {
+    OSCCON1 = 0x60 | profile;      // NOSC = HFINTOSC, NDIV = profile
+    while (!OSCCON3bits.ORDY);     // Wait for the switch to complete
+    clockProfile = profile;
+}
+
+// Fosc of the profile running now
+unsigned long clock_hz(void) {
+    return 64000000UL >> clockProfile;
+}
+
+// Prescaler code for a 250 kHz count rate (1 ms = 250 counts) at the profile running now
+unsigned char clock_tick_ckps(void) {
+    return CLOCK_1MHZ - clockProfile;
+}
+
+// UART baud rate generator value (BRGS = 1) at the profile running now
+unsigned int clock_uart_brg(unsigned long baud) {
+    return (unsigned int)((clock_hz() + 2UL * baud) / (4UL * baud) - 1);
+}
+
+// Millisecond delay, correct at any profile: one unit is 1/64 ms at 64 MHz and NDIV
+// stretches it, so a millisecond takes 64 >> profile units
+void clock_delay_ms(unsigned int ms) {
+    unsigned char units;
+
+    while (ms--) {
+        for (units = 64 >> clockProfile; units > 0; units--) {
+            _delay(240);           // 250 instruction cycles per unit with the loop
+        }
+    }
+}
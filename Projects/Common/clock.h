@@ -0,0 +1,72 @@
+/*
+ * File: clock.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: System clock profiles shared by the C projects, the one place _XTAL_FREQ is defined.
+ *          The core runs from HFINTOSC at 64 MHz divided by NDIV, so every profile is reached with
+ *          one OSCCON1 write and the clock can be switched at run time. CLOCK_PROFILE picks the
+ *          start-up profile (4 MHz if not defined); set it for the whole build, the project
+ *          Makefile passes it to every module. The oscillator configuration bits are in clock.c.
+ *          __delay_ms()/__delay_us() and the CLOCK_ macros follow the start-up profile,
+ *          clock_delay_ms() and clock_uart_brg() follow the clock actually running.
+ */
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <xc.h>
+
+//=============================================================================
+// CLOCK PROFILES
+//=============================================================================
+
+// Profile values are the NDIV codes dividing HFINTOSC 64 MHz
+#define CLOCK_64MHZ         0       // NDIV 1:1
+#define CLOCK_16MHZ         2       // NDIV 1:4
+#define CLOCK_4MHZ          4       // NDIV 1:16
+#define CLOCK_1MHZ          6       // NDIV 1:64
+
+#ifndef CLOCK_PROFILE
+#define CLOCK_PROFILE       CLOCK_4MHZ
+#endif
+
+#if CLOCK_PROFILE == CLOCK_64MHZ
+#define _XTAL_FREQ          64000000UL  // Fosc for the __delay_ms()/__delay_us() library
+#elif CLOCK_PROFILE == CLOCK_16MHZ
+#define _XTAL_FREQ          16000000UL
+#elif CLOCK_PROFILE == CLOCK_4MHZ
+#define _XTAL_FREQ          4000000UL
+#elif CLOCK_PROFILE == CLOCK_1MHZ
+#define _XTAL_FREQ          1000000UL
+#else
+#error "CLOCK_PROFILE must be CLOCK_64MHZ, CLOCK_16MHZ, CLOCK_4MHZ or CLOCK_1MHZ"
+#endif
+
+#define FCY                 (_XTAL_FREQ / 4)    // Instruction cycle rate
+
+//=============================================================================
+// TIMER AND BAUD HELPERS (start-up profile)
+//=============================================================================
+
+// Timer prescaler code giving Fosc/4 / 250 kHz: a 1 ms period is always 250 counts.
+// The prescaler ratio codes of Timer0 (T0CON1 CKPS) and Timer2 (T2CON CKPS) are both 2^n.
+#define CLOCK_TICK_CKPS     (CLOCK_1MHZ - CLOCK_PROFILE)
+#define CLOCK_TICK_HZ       250000UL    // Count rate with CLOCK_TICK_CKPS
+#define CLOCK_TICK_PERIOD   249         // Period match value for 1 ms at CLOCK_TICK_HZ
+
+// UART baud rate generator value, high speed mode (BRGS = 1): Fosc / (4 * baud) - 1, rounded
+#define CLOCK_UART_BRG(baud)    ((unsigned int)((_XTAL_FREQ + 2UL * (baud)) / (4UL * (baud)) - 1))
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void clock_init(void);  // Switch to the start-up profile, call first
+void clock_switch(unsigned char profile);  // Change the system clock at run time
+unsigned long clock_hz(void);  // Fosc of the profile running now
+unsigned char clock_tick_ckps(void);  // CLOCK_TICK_CKPS for the profile running now
+unsigned int clock_uart_brg(unsigned long baud);  // CLOCK_UART_BRG for the profile running now
+void clock_delay_ms(unsigned int ms);  // Millisecond delay, correct at any profile
+
+#endif /* CLOCK_H */
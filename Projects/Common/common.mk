@@ -0,0 +1,47 @@
+# File: common.mk
+# Author: Huy Nguyen
+#
+# Created on October 14, 2026
+#
+# Purpose: XC8 build rules shared by the C projects. A project Makefile sets the variables
+#          below and includes this file, every module is compiled on its own to a .p1 object
+#          and only the listed Common modules are linked.
+#            PROJECT     Name of the .hex file
+#            SOURCES     Project .c files
+#            COMMON      Common modules the project uses, without .c
+#            COMMON_DIR  Path to Projects/Common
+#            DEFS        Build-wide options (-D), passed to the project and the Common modules
+#          make PROF=1 builds with PROF_ENABLE and links Common/prof.c (Common/prof.h).
+
+CC      = xc8-cc
+MCU     = 18F47K42
+BUILD   = build
+CFLAGS  = -mcpu=$(MCU) -O2 -std=c99 $(DEFS)
+
+ifeq ($(PROF),1)
+CFLAGS  += -DPROF_ENABLE
+COMMON  += prof
+endif
+
+OBJECTS = $(addprefix $(BUILD)/,$(SOURCES:.c=.p1)) \
+          $(addprefix $(BUILD)/common/,$(addsuffix .p1,$(COMMON)))
+HEADERS = $(wildcard *.h) $(wildcard $(COMMON_DIR)/*.h)
+
+all: $(BUILD)/$(PROJECT).hex
+
+$(BUILD)/$(PROJECT).hex: $(OBJECTS)
+	$(CC) $(CFLAGS) -o $@ $(OBJECTS)
+
+$(BUILD)/%.p1: %.c $(HEADERS) Makefile | $(BUILD)
+	$(CC) $(CFLAGS) -c -o $@ $<
+
+$(BUILD)/common/%.p1: $(COMMON_DIR)/%.c $(HEADERS) Makefile | $(BUILD)/common
+	$(CC) $(CFLAGS) -c -o $@ $<
+
+$(BUILD) $(BUILD)/common:
+	mkdir -p $@
+
+clean:
+	rm -rf $(BUILD)
+
+.PHONY: all clean
@@ -0,0 +1,95 @@
+/*
+ * File: debounce.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Vertical-counter debouncer for PORTA-PORTC (debounce.h).
+ */
+
+#include <xc.h>
+#include "debounce.h"
+
+//=============================================================================
+// DEBOUNCE STATE
+//=============================================================================
+volatile Debounce debouncePorts[DEBOUNCE_PORTS];  // Written by debounce_tick(), edges cleared by the takers
+static unsigned char debounceDivider = 0;         // Ticks until the next sample
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Start from the current pin levels so no edges are reported at start-up
+void debounce_init(void) {
+    unsigned char raw[DEBOUNCE_PORTS];
+    unsigned char i;
+
+    raw[DEBOUNCE_PORTA] = PORTA;
+    raw[DEBOUNCE_PORTB] = PORTB;
+    raw[DEBOUNCE_PORTC] = PORTC;
+    for (i = 0; i < DEBOUNCE_PORTS; i++) {
+        debouncePorts[i].state = raw[i];
+        debouncePorts[i].cnt0 = 0;
+        debouncePorts[i].cnt1 = 0;
+        debouncePorts[i].rose = 0;
+        debouncePorts[i].fell = 0;
+    }
+    debounceDivider = DEBOUNCE_TICKS;
+}
+
+// Sample the ports every DEBOUNCE_TICKS calls, call every 1 ms from a timer interrupt
+void debounce_tick(void) {
+    if (--debounceDivider != 0) {
+        return;
+    }
+    debounceDivider = DEBOUNCE_TICKS;
+
+    debounce_sample(&debouncePorts[DEBOUNCE_PORTA], PORTA);  // Ports read back to back
+    debounce_sample(&debouncePorts[DEBOUNCE_PORTB], PORTB);
+    debounce_sample(&debouncePorts[DEBOUNCE_PORTC], PORTC);
+}
+
+// Run one sample through a port's counters. Pins that differ from the debounced level count
+// 1, 2, 3 and flip the level when the count wraps back to 0, pins that agree reset to 0.
+void debounce_sample(volatile Debounce *d, unsigned char raw) {
+    unsigned char delta = raw ^ d->state;  // Pins not at their debounced level
+    unsigned char toggle;
+
+    d->cnt1 = (d->cnt1 ^ d->cnt0) & delta;
+    d->cnt0 = ~d->cnt0 & delta;
+    toggle = delta & ~(d->cnt0 | d->cnt1);  // Count ran out: 4 samples agreed
+    d->state ^= toggle;
+    d->rose |= toggle & d->state;
+    d->fell |= toggle & ~d->state;
+}
+
+// Debounced levels of a port
+unsigned char debounce_state(unsigned char port) {
+    return debouncePorts[port].state;
+}
+
+// Take the rising edges in mask since the last call, the tick cannot add one in between.
+// Interrupts are restored as they were, so the tick ISR itself can take edges too.
+unsigned char debounce_rose(unsigned char port, unsigned char mask) {
+    unsigned char gie = INTCON0bits.GIE;  // Already 0 inside a high-priority ISR
+    unsigned char edges;
+
+    INTCON0bits.GIE = 0;
+    edges = debouncePorts[port].rose & mask;
+    debouncePorts[port].rose &= ~mask;
+    INTCON0bits.GIE = gie;
+    return edges;
+}
+
+// Take the falling edges in mask since the last call
+unsigned char debounce_fell(unsigned char port, unsigned char mask) {
+    unsigned char gie = INTCON0bits.GIE;  // Already 0 inside a high-priority ISR
+    unsigned char edges;
+
+    INTCON0bits.GIE = 0;
+    edges = debouncePorts[port].fell & mask;
+    debouncePorts[port].fell &= ~mask;
+    INTCON0bits.GIE = gie;
+    return edges;
+}
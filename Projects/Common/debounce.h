@@ -0,0 +1,59 @@
+/*
+ * File: debounce.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Integrator debouncer shared by the C projects for every digital input on PORTA-PORTC.
+ *          debounce_tick(), called every 1 ms from the project's tick interrupt, samples the whole
+ *          ports every DEBOUNCE_TICKS ms and runs all 8 pins of a port at once through a 2-bit
+ *          vertical counter: a pin's debounced level only changes after 4 samples in a row agree
+ *          (20 ms with the default), a bounce restarts its count. Changes are latched as rising and
+ *          falling edge bitmasks taken with debounce_rose()/debounce_fell(), from the main loop
+ *          or from an ISR (Project_4 takes the confirm button edge in its tick).
+ *          Nothing waits, bits of pins that are outputs or analog are simply ignored by the caller.
+ */
+
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <xc.h>
+
+//=============================================================================
+// DEBOUNCE DEFINITIONS
+//=============================================================================
+#ifndef DEBOUNCE_TICKS
+#define DEBOUNCE_TICKS      5       // Ticks (ms) between samples, stable time = 4 samples
+#endif
+
+// Port indexes
+#define DEBOUNCE_PORTA      0
+#define DEBOUNCE_PORTB      1
+#define DEBOUNCE_PORTC      2
+#define DEBOUNCE_PORTS      3
+
+// Debounce state of one port, one bit per pin
+typedef struct {
+    unsigned char state;   // Debounced level
+    unsigned char cnt0;    // Vertical counter, low bit of each pin's count
+    unsigned char cnt1;    // Vertical counter, high bit of each pin's count
+    unsigned char rose;    // Rising edges not taken yet
+    unsigned char fell;    // Falling edges not taken yet
+} Debounce;
+
+//=============================================================================
+// DEBOUNCE STATE
+//=============================================================================
+extern volatile Debounce debouncePorts[DEBOUNCE_PORTS];  // Written by debounce_tick(), edges cleared by the takers
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void debounce_init(void);  // Start from the current pin levels, call after the pins are set up
+void debounce_tick(void);  // Sample the ports, call every 1 ms from a timer interrupt
+void debounce_sample(volatile Debounce *d, unsigned char raw);  // Run one sample through a port's counters
+unsigned char debounce_state(unsigned char port);  // Debounced levels of a port
+unsigned char debounce_rose(unsigned char port, unsigned char mask);  // Take the rising edges in mask
+unsigned char debounce_fell(unsigned char port, unsigned char mask);  // Take the falling edges in mask
+
+#endif /* DEBOUNCE_H */
@@ -0,0 +1,88 @@
+/*
+ * File: filter.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Median, moving average and IIR stages of the ADC sample filter (filter.h).
+ */
+
+#include "filter.h"
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Forget the history, the next sample primes the filter
+void filter_reset(Filter *f) {
+    f->primed = 0;
+}
+
+// Median of 3 values, 3 compares
+unsigned int filter_median3(unsigned int a, unsigned int b, unsigned int c) {
+    if (a > b) {
+        unsigned int t = a; a = b; b = t;  // Now a <= b
+    }
+    if (c <= a) {
+        return a;
+    }
+    return (c < b) ? c : b;
+}
+
+// Median of 5 values in 6 compares: twice drop the smallest of two sorted pairs, the
+// median is then the smaller of the two values in the middle
+unsigned int filter_median5(const unsigned int *v) {
+    unsigned int a = v[0], b = v[1], c = v[2], d = v[3], t;
+
+    if (a > b) { t = a; a = b; b = t; }   // Pairs a <= b and c <= d
+    if (c > d) { t = c; c = d; d = t; }
+    if (a > c) { t = a; a = c; c = t; t = b; b = d; d = t; }  // a is the smallest of four, drop it
+    a = v[4];
+    if (a > b) { t = a; a = b; b = t; }   // New pair a <= b with the fifth value
+    if (a > c) { t = c; c = a; a = t; t = b; b = d; d = t; }  // Drop the smallest again
+    return (b < c) ? b : c;
+}
+
+// Filter one sample with the stages in c
+unsigned int filter_step(Filter *f, const FilterConfig *c, unsigned int x) {
+    unsigned char i;
+
+    if (!f->primed) { // Fill every stage with the first sample
+        for (i = 0; i < 5; i++) {
+            f->median[i] = x;
+        }
+        for (i = 0; i < (1 << FILTER_MAX_SHIFT); i++) {
+            f->window[i] = x;
+        }
+        f->sum = (unsigned long)x << c->shift;
+        f->medianPos = 0;
+        f->windowPos = 0;
+        f->primed = 1;
+        return x;
+    }
+
+    // Spike rejection
+    if (c->mode & (FILTER_MEDIAN3 | FILTER_MEDIAN5)) {
+        f->median[f->medianPos] = x;
+        if (c->mode & FILTER_MEDIAN5) {
+            f->medianPos = (f->medianPos < 4) ? f->medianPos + 1 : 0;
+            x = filter_median5(f->median);
+        } else {
+            f->medianPos = (f->medianPos < 2) ? f->medianPos + 1 : 0;
+            x = filter_median3(f->median[0], f->median[1], f->median[2]);
+        }
+    }
+
+    // Smoothing
+    if (c->mode & FILTER_AVERAGE) { // Running sum: add the new sample, drop the oldest
+        f->sum += x;
+        f->sum -= f->window[f->windowPos];
+        f->window[f->windowPos] = x;
+        f->windowPos = (f->windowPos + 1) & ((1 << c->shift) - 1);
+        x = (unsigned int)(f->sum >> c->shift);
+    } else if (c->mode & FILTER_IIR) { // sum = y << shift, y += (x - y) >> shift
+        f->sum = f->sum - (f->sum >> c->shift) + x;
+        x = (unsigned int)(f->sum >> c->shift);
+    }
+    return x;
+}
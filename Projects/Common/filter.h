@@ -0,0 +1,53 @@
+/*
+ * File: filter.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Integer filters for ADC sample streams, one Filter state per channel.
+ *          A FilterConfig picks an optional 3- or 5-tap median for spike rejection followed by
+ *          an optional smoothing stage: a 2^shift moving average kept as a running sum, or a
+ *          first-order IIR y += (x - y) / 2^shift. No multiply, divide or float; the first
+ *          sample after filter_reset() primes every stage, so there is no start-up ramp.
+ *          Samples are 16-bit and the sums 32-bit, so nothing overflows.
+ */
+
+#ifndef FILTER_H
+#define FILTER_H
+
+//=============================================================================
+// FILTER DEFINITIONS
+//=============================================================================
+
+// FilterConfig.mode: one median stage and one smoothing stage can be combined
+#define FILTER_NONE         0x00    // Pass samples through
+#define FILTER_MEDIAN3      0x01    // Median of the last 3 samples
+#define FILTER_MEDIAN5      0x02    // Median of the last 5 samples
+#define FILTER_AVERAGE      0x10    // Moving average of the last 2^shift samples
+#define FILTER_IIR          0x20    // First-order low-pass with coefficient 1/2^shift
+
+#define FILTER_MAX_SHIFT    4       // Longest moving average is 16 samples
+
+typedef struct {
+    unsigned char mode;    // FILTER_ flags
+    unsigned char shift;   // Average length or IIR coefficient as a power of two, 0 to FILTER_MAX_SHIFT
+} FilterConfig;
+
+typedef struct {
+    unsigned int median[5];                      // Last samples for the median stage
+    unsigned int window[1 << FILTER_MAX_SHIFT];  // Last median outputs for the moving average
+    unsigned long sum;     // Running sum of the window, or the IIR output << shift
+    unsigned char medianPos;  // Oldest entry of median[]
+    unsigned char windowPos;  // Oldest entry of window[]
+    unsigned char primed;     // 0 until the first sample after filter_reset()
+} Filter;
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void filter_reset(Filter *f);  // Forget the history, the next sample primes the filter
+unsigned int filter_step(Filter *f, const FilterConfig *c, unsigned int x);  // Filter one sample
+unsigned int filter_median3(unsigned int a, unsigned int b, unsigned int c);  // Median of 3 values
+unsigned int filter_median5(const unsigned int *v);  // Median of 5 values
+
+#endif /* FILTER_H */
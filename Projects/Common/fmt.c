@@ -0,0 +1,67 @@
+/*
+ * File: fmt.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Fixed-width number formatters (fmt.h).
+ */
+
+#include <stdbool.h>
+#include "bcd.h"
+#include "fmt.h"
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Format x with decimals digits after the point ("0.05" for x = 5, decimals = 2) and a '-'
+// in front if negative, right-aligned in dst[0] to dst[width - 1]. Returns false and fills
+// the field with FMT_OVERFLOW if it does not fit.
+bool fmt_number(char *dst, unsigned char width, unsigned long x, bool negative, unsigned char decimals) {
+    unsigned char pos = width;     // Written right to left, dst[pos] is the last character written
+    unsigned char digits = 0;
+    unsigned long q;
+
+    while (pos != 0) {
+        q = (x > 0xFFFF) ? bcd_div10_u32(x) : bcd_div10_u16((unsigned int)x);
+        dst[--pos] = '0' + (unsigned char)(x - q * 10);
+        x = q;
+
+        if (++digits == decimals && pos != 0) {
+            dst[--pos] = '.';
+        } else if (x == 0 && digits > decimals) { // All digits and a leading 0 before the point
+            if (negative && pos != 0) {
+                dst[--pos] = '-';
+                negative = false;
+            }
+            if (!negative) {
+                while (pos != 0) {
+                    dst[--pos] = ' ';
+                }
+                return true;
+            }
+        }
+    }
+
+    for (pos = 0; pos < width; pos++) { // Too narrow
+        dst[pos] = FMT_OVERFLOW;
+    }
+    return false;
+}
+
+// Format 0-65535 right-aligned in width characters
+bool fmt_u16(char *dst, unsigned char width, unsigned int x) {
+    return fmt_number(dst, width, x, false, 0);
+}
+
+// Format -32768-32767 right-aligned in width characters
+bool fmt_s16(char *dst, unsigned char width, int x) {
+    return fmt_number(dst, width, x < 0 ? 0u - (unsigned int)x : (unsigned int)x, x < 0, 0);
+}
+
+// Format a fixed-point value in units of 10^-decimals ("1498.30" for 149830, decimals = 2)
+bool fmt_fixed(char *dst, unsigned char width, long value, unsigned char decimals) {
+    return fmt_number(dst, width, value < 0 ? 0UL - (unsigned long)value : (unsigned long)value,
+                      value < 0, decimals);
+}
@@ -0,0 +1,36 @@
+/*
+ * File: fmt.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Integer and fixed-point number formatting for the display paths, in place of the
+ *          XC8 printf engine. Every formatter writes exactly width characters, right-aligned
+ *          and space padded, straight into the destination (an LCD shadow buffer row, say)
+ *          without a terminating zero, so it can never write past the field. A number that
+ *          does not fit fills the field with FMT_OVERFLOW instead of being cut.
+ *          Digits come from the Common/bcd.h divide-by-10, no software division is used.
+ *          The output is ASCII '0'-'9', '.', '-' and ' ', which a 7-segment driver maps
+ *          through its segment table.
+ */
+
+#ifndef FMT_H
+#define FMT_H
+
+#include <stdbool.h>
+#include "bcd.h"
+
+//=============================================================================
+// FORMAT DEFINITIONS
+//=============================================================================
+#define FMT_OVERFLOW        '#'     // Fills a field that is too narrow for the number
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+bool fmt_number(char *dst, unsigned char width, unsigned long x, bool negative, unsigned char decimals);  // Format a magnitude and sign
+bool fmt_u16(char *dst, unsigned char width, unsigned int x);  // Format 0-65535
+bool fmt_s16(char *dst, unsigned char width, int x);  // Format -32768-32767
+bool fmt_fixed(char *dst, unsigned char width, long value, unsigned char decimals);  // Format value / 10^decimals
+
+#endif /* FMT_H */
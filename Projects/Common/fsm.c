@@ -0,0 +1,123 @@
+/*
+ * File: fsm.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Event queue, one-shot timer and table dispatch of the state machine (fsm.h).
+ */
+
+#include <xc.h>
+#include <stdbool.h>
+#include "timebase.h"
+#include "fsm.h"
+
+//=============================================================================
+// FSM STATE
+//=============================================================================
+static volatile FsmEvent fsmQueue[FSM_QUEUE_SIZE];  // Posted events, oldest at fsmTail
+static volatile unsigned char fsmHead = 0;          // Next slot written by fsm_post()
+static volatile unsigned char fsmTail = 0;          // Next event taken by fsm_get()
+static volatile unsigned int fsmDropped = 0;        // Events lost to a full queue
+static volatile unsigned int fsmTimerLeft = 0;      // Milliseconds until the timer event, 0 = stopped
+static volatile unsigned char fsmTimerEvent = 0;    // Event posted when the timer runs out
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Queue an event, from the main loop or any ISR. Returns false if the queue is full and the
+// event is dropped.
+bool fsm_post(unsigned char type, unsigned char data) {
+    unsigned char gie = INTCON0bits.GIE;  // Already 0 inside a high-priority ISR
+    unsigned char next;
+    bool posted = false;
+
+    INTCON0bits.GIE = 0;
+    next = (fsmHead + 1) & (FSM_QUEUE_SIZE - 1);
+    if (next != fsmTail) {
+        fsmQueue[fsmHead].type = type;
+        fsmQueue[fsmHead].data = data;
+        fsmQueue[fsmHead].stamp = timebaseMillis;
+        fsmHead = next;
+        posted = true;
+    } else {
+        fsmDropped++;
+    }
+    INTCON0bits.GIE = gie;
+    return posted;
+}
+
+// Take the oldest event in the main loop. Returns false if there is none.
+bool fsm_get(FsmEvent *event) {
+    if (fsmTail == fsmHead) {
+        return false;
+    }
+    event->type = fsmQueue[fsmTail].type;
+    event->data = fsmQueue[fsmTail].data;
+    event->stamp = fsmQueue[fsmTail].stamp;
+    fsmTail = (fsmTail + 1) & (FSM_QUEUE_SIZE - 1);
+    return true;
+}
+
+// Check if an event is queued, for POWER_IDLE_UNLESS()
+bool fsm_pending(void) {
+    return fsmTail != fsmHead;
+}
+
+// Post type once ms milliseconds have passed, replacing a timer already running
+void fsm_timer_start(unsigned int ms, unsigned char type) {
+    unsigned char gie = INTCON0bits.GIE;
+
+    INTCON0bits.GIE = 0;           // 16-bit count shared with fsm_tick()
+    fsmTimerEvent = type;
+    fsmTimerLeft = ms ? ms : 1;
+    INTCON0bits.GIE = gie;
+}
+
+// Cancel the timer event. An event already posted stays in the queue.
+void fsm_timer_stop(void) {
+    unsigned char gie = INTCON0bits.GIE;
+
+    INTCON0bits.GIE = 0;
+    fsmTimerLeft = 0;
+    INTCON0bits.GIE = gie;
+}
+
+// Step the timer, call every 1 ms from a timer interrupt
+void fsm_tick(void) {
+    if (fsmTimerLeft && --fsmTimerLeft == 0) {
+        fsm_post(fsmTimerEvent, 0);
+    }
+}
+
+// Run the first transition that matches the current state and the event type. Returns false
+// if there is none and the event is ignored.
+bool fsm_dispatch(Fsm *fsm, const FsmEvent *event) {
+    const FsmTransition *t = fsm->table;
+    unsigned char next;
+
+    for (unsigned char i = 0; i < fsm->count; i++, t++) {
+        if ((t->state == fsm->state || t->state == FSM_ANY)
+                && (t->event == event->type || t->event == FSM_ANY)) {
+            next = t->action ? t->action(event) : FSM_NEXT;
+            if (next == FSM_NEXT) {
+                next = t->next;
+            }
+            if (next != FSM_SAME) {
+                fsm->state = next;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// Dispatch every queued event, in the order they were posted
+void fsm_run(Fsm *fsm) {
+    FsmEvent event;
+
+    while (fsm_get(&event)) {
+        fsm_dispatch(fsm, &event);
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * File: fsm.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Table-driven finite state machine and the event queue that feeds it, shared by
+ *          the C projects. ISRs (and tasks) post events with fsm_post(); the main loop hands
+ *          each queued event to fsm_dispatch(), which looks up the first transition matching
+ *          the current state and the event type, runs its action and moves to its next state,
+ *          then idles while fsm_pending() is false. Actions only update outputs and start
+ *          timers, so no state ever waits. An event without a matching transition is dropped.
+ *          One one-shot timer, stepped by fsm_tick() from the 1 ms interrupt, posts a chosen
+ *          event when it runs out, for states that time out or blink.
+ *          fsm_post() masks interrupts around the queue update, so it is safe from the main
+ *          loop and from ISRs of either priority. FSM_QUEUE_SIZE is set for the whole build.
+ */
+
+#ifndef FSM_H
+#define FSM_H
+
+#include <xc.h>
+#include <stdbool.h>
+
+//=============================================================================
+// FSM DEFINITIONS
+//=============================================================================
+#ifndef FSM_QUEUE_SIZE
+#define FSM_QUEUE_SIZE      8       // Pending events (power of two)
+#endif
+
+#define FSM_ANY             0xFF    // Transition state or event that matches any value
+#define FSM_SAME            0xFE    // Next state: stay in the current state
+#define FSM_NEXT            0xFD    // Action result: take the next state from the table
+
+typedef struct {
+    unsigned char type;    // Project event type
+    unsigned char data;    // Event argument, e.g. the key value
+    unsigned int stamp;    // timebase millisecond count when it was posted
+} FsmEvent;
+
+// Action run by a transition. Returns the next state, FSM_SAME, or FSM_NEXT for the table's.
+// Actions that do not need the event start with (void)event;
+typedef unsigned char (*FsmAction)(const FsmEvent *event);
+
+typedef struct {
+    unsigned char state;   // State the transition leaves, or FSM_ANY
+    unsigned char event;   // Event type that fires it, or FSM_ANY
+    FsmAction action;      // Run before the state changes, 0 for none
+    unsigned char next;    // Next state, or FSM_SAME
+} FsmTransition;
+
+typedef struct {
+    const FsmTransition *table;  // Transitions, checked in order
+    unsigned char count;         // Entries in table
+    unsigned char state;         // Current state
+} Fsm;
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+bool fsm_post(unsigned char type, unsigned char data);  // Queue an event, from any context
+bool fsm_get(FsmEvent *event);  // Take the oldest event in the main loop
+bool fsm_pending(void);  // Check if an event is queued
+void fsm_timer_start(unsigned int ms, unsigned char type);  // Post type after ms milliseconds
+void fsm_timer_stop(void);  // Cancel the timer event
+void fsm_tick(void);  // Step the timer, call every 1 ms from a timer interrupt
+bool fsm_dispatch(Fsm *fsm, const FsmEvent *event);  // Run the transition for an event
+void fsm_run(Fsm *fsm);  // Dispatch every queued event
+
+#endif /* FSM_H */
@@ -0,0 +1,126 @@
+/*
+ * File: keypad.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Keypad row interrupt, scan and release debounce (keypad.h).
+ */
+
+#include <xc.h>
+#include <stdbool.h>
+#include "keypad.h"
+
+//=============================================================================
+// KEYPAD MAP
+//=============================================================================
+
+// Key values by scan code, physical layout:  1 2 3 A / 4 5 6 B / 7 8 9 C / * 0 # D
+const unsigned char keypad_map[16] = {
+    0x01,     0x02, 0x03,     0x0A,   // Row 1
+    0x04,     0x05, 0x06,     0x0B,   // Row 2
+    0x07,     0x08, 0x09,     0x0C,   // Row 3
+    KEY_STAR, 0x00, KEY_HASH, 0x0D    // Row 4
+};
+
+//=============================================================================
+// DRIVER STATE
+//=============================================================================
+static volatile unsigned char keypadFifo[KEYPAD_FIFO_SIZE];  // Scan codes of queued presses
+static volatile unsigned char keypadHead = 0;    // Written by the ISR only
+static volatile unsigned char keypadTail = 0;    // Written by keypad_get() only
+static volatile bool keypadHeld = false;         // A press is in progress, ignore row edges
+static volatile unsigned char keypadQuiet = 0;   // Milliseconds the rows have been low
+static KeypadPost keypadPost = 0;                // Press hook, 0 = queue in the FIFO
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Configure the keypad pins and the row IOC interrupt. With a post hook every press goes to
+// it from the ISR, with 0 presses queue for keypad_get().
+void keypad_init(KeypadPost post) {
+    ANSELB = 0x00;                 // Digital I/O on all keypad pins
+    TRISB = KEYPAD_ROWS_MASK;      // Columns outputs, rows inputs
+    WPUB = 0x00;                   // Rows use external pull-down resistors
+    LATB |= KEYPAD_COLS_MASK;      // Idle state: all columns HIGH
+
+    keypadHead = 0;
+    keypadTail = 0;
+    keypadHeld = false;
+    keypadQuiet = 0;
+    keypadPost = post;
+
+    IOCBP |= KEYPAD_ROWS_MASK;     // Rising edge on any row: key pressed
+    IOCBF &= ~KEYPAD_ROWS_MASK;   // Clear the row flags, the only IOC pins (see keypad.h)
+    PIR0bits.IOCIF = 0;
+    PIE0bits.IOCIE = 1;            // Caller enables global interrupts
+}
+
+// Take the next scan code (row * 4 + column), KEYPAD_NONE if the FIFO is empty
+unsigned char keypad_get(void) {
+    unsigned char code;
+
+    if (keypadTail == keypadHead) {
+        return KEYPAD_NONE;
+    }
+    code = keypadFifo[keypadTail];
+    keypadTail = (keypadTail + 1) & (KEYPAD_FIFO_SIZE - 1);
+    return code;
+}
+
+// Check if a key press is queued
+bool keypad_available(void) {
+    return keypadTail != keypadHead;
+}
+
+// Release debounce, call every 1 ms from a timer interrupt
+void keypad_tick(void) {
+    if (!keypadHeld) {
+        return;
+    }
+    if (PORTB & KEYPAD_ROWS_MASK) {  // Still pressed (or bouncing)
+        keypadQuiet = 0;
+    } else if (++keypadQuiet >= KEYPAD_RELEASE_MS) {
+        keypadHeld = false;          // Released, the next rising edge is a new press
+    }
+}
+
+// Row change interrupt: one fast scan, no delays
+void __interrupt(irq(IRQ_IOC), base(KEYPAD_IVT_BASE)) keypad_ISR(void) {
+    unsigned char col, rows, row;
+    unsigned char next;
+
+    IOCBF &= ~KEYPAD_ROWS_MASK;   // Clear the row flags, IOCIF follows them
+    PIR0bits.IOCIF = 0;
+
+    if (keypadHeld) {
+        return;                    // Bounce or second key of the same press
+    }
+
+    for (col = 0; col < 4; col++) {
+        LATB = (LATB & KEYPAD_ROWS_MASK) | (1 << col);  // Only this column HIGH
+        NOP();                     // Let the row pins settle
+        NOP();
+        rows = PORTB >> 4;
+        if (rows) {
+            for (row = 0; !(rows & 1); row++) {  // Lowest row that is up
+                rows >>= 1;
+            }
+            if (keypadPost) {
+                keypadPost((row << 2) | col);
+            } else {
+                next = (keypadHead + 1) & (KEYPAD_FIFO_SIZE - 1);
+                if (next != keypadTail) {  // Drop the press if the FIFO is full
+                    keypadFifo[keypadHead] = (row << 2) | col;
+                    keypadHead = next;
+                }
+            }
+            keypadHeld = true;
+            keypadQuiet = 0;
+            break;
+        }
+    }
+
+    LATB |= KEYPAD_COLS_MASK;      // Back to the idle state
+}
@@ -0,0 +1,60 @@
+/*
+ * File: keypad.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Interrupt driven 4x4 matrix keypad driver shared by the C projects.
+ *          Columns on RB0-RB3 (outputs), rows on RB4-RB7 (inputs with external pull-down resistors).
+ *          All columns are held HIGH while idle, so a key press raises its row and triggers
+ *          interrupt-on-change. The ISR finds the key with one fast scan and queues its
+ *          scan code (row * 4 + column) in a small FIFO. keypad_tick() must be called every 1 ms
+ *          from a timer interrupt and ends a press once the rows have been low for KEYPAD_RELEASE_MS.
+ *          A project that passes a KeypadPost hook to keypad_init() gets each press handed to it
+ *          from the ISR instead (to post an event, see Common/fsm.h) and leaves the FIFO unused.
+ *          keypad_map[] turns a scan code into the key printed on the keypad.
+ *          The keypad owns PORTB and the IRQ_IOC vector: keypad_ISR() services only the row flags,
+ *          so no other pin of the project may have interrupt-on-change enabled (its flag would
+ *          keep IOCIF set and the ISR would run again and again).
+ */
+
+#ifndef KEYPAD_H
+#define KEYPAD_H
+
+#include <xc.h>
+#include <stdbool.h>
+
+//=============================================================================
+// KEYPAD DEFINITIONS
+//=============================================================================
+#ifndef KEYPAD_IVT_BASE
+#define KEYPAD_IVT_BASE     0x0008  // Interrupt vector table base of the project
+#endif
+
+#define KEYPAD_COLS_MASK    0x0F    // RB0-RB3 columns
+#define KEYPAD_ROWS_MASK    0xF0    // RB4-RB7 rows
+#define KEYPAD_FIFO_SIZE    8       // Queued key presses (power of two)
+#define KEYPAD_RELEASE_MS   20      // Rows must stay low this long to end a press
+#define KEYPAD_NONE         0xFF    // No key available
+
+#define KEY_STAR            0x0E    // '*' key value
+#define KEY_HASH            0x0F    // '#' key value
+
+// Hook that takes each scan code from the ISR, in place of the FIFO
+typedef void (*KeypadPost)(unsigned char code);
+
+//=============================================================================
+// KEYPAD MAP
+//=============================================================================
+extern const unsigned char keypad_map[16];  // Key values by scan code, in program memory
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void keypad_init(KeypadPost post);  // Configure the keypad pins and the row IOC interrupt, 0 = FIFO
+unsigned char keypad_get(void);  // Take the next scan code, KEYPAD_NONE if none
+bool keypad_available(void);  // Check if a key press is queued
+void keypad_tick(void);  // Release debounce, call every 1 ms from a timer interrupt
+void __interrupt(irq(IRQ_IOC), base(KEYPAD_IVT_BASE)) keypad_ISR(void);  // Row change interrupt
+
+#endif /* KEYPAD_H */
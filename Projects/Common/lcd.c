@@ -0,0 +1,194 @@
+/*
+ * File: lcd.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: HD44780 transfers, shadow buffer and step-wise flush (lcd.h).
+ */
+
+#include <xc.h>
+#include <string.h>
+#include "clock.h"
+#include "timebase.h"
+#include "fmt.h"
+#include "lcd.h"
+
+//=============================================================================
+// DRIVER STATE
+//=============================================================================
+static char lcdShadow[LCD_ROWS][LCD_COLS];   // Text the program wants on the LCD
+static char lcdScreen[LCD_ROWS][LCD_COLS];   // Text the LCD is showing now
+static unsigned char lcdFlushPos = 0;        // Next cell lcd_flush_step() checks (row * LCD_COLS + column)
+static unsigned char lcdCursor = LCD_CURSOR_UNKNOWN;  // Cell the LCD address counter points to
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Latch the data with a high-to-low pulse on EN
+void lcd_pulse(void) {
+    LCD_EN = 1;
+    __delay_us(1);                 // E pulse width, 450 ns minimum
+    LCD_EN = 0;
+}
+
+// Wait until the LCD can take the next transfer
+void lcd_wait(void) {
+#if LCD_USE_BUSY_FLAG
+    unsigned int timeout = LCD_BUSY_TIMEOUT;
+    unsigned char busy;
+
+    LCD_DATA_TRIS |= LCD_DATA_MASK;  // Release the data pins so the LCD can drive them
+    LCD_RS = 0;                    // Busy flag is read from the command register
+    LCD_RW = 1;
+    do {
+        LCD_EN = 1;
+        __delay_us(1);             // Data valid 360 ns after E rises
+        busy = LCD_BUSY;
+        LCD_EN = 0;
+#if LCD_4BIT_MODE
+        lcd_pulse();               // Clock out the low nibble of the address
+#endif
+    } while (busy && --timeout);   // Timeout keeps a missing LCD from hanging the loop
+    LCD_RW = 0;
+    LCD_DATA_TRIS &= LCD_DATA_KEEP;  // Data pins back to outputs
+#endif
+}
+
+// Send one byte to the command (rs = 0) or data (rs = 1) register
+void lcd_write(unsigned char value, unsigned char rs) {
+    lcd_wait();
+    LCD_RS = rs;
+    LCD_RW = 0;
+#if LCD_4BIT_MODE
+    LCD_DATA = (LCD_DATA & LCD_DATA_KEEP) | (value & 0xF0);  // High nibble first
+    lcd_pulse();
+    LCD_DATA = (LCD_DATA & LCD_DATA_KEEP) | (unsigned char)(value << 4);
+    lcd_pulse();
+#else
+    LCD_DATA = value;
+    lcd_pulse();
+#endif
+#if !LCD_USE_BUSY_FLAG
+    if (rs == 0 && value <= 0x03) {
+        __delay_us(1600);          // Clear and home take 1.52 ms
+    } else {
+        __delay_us(40);            // Every other instruction takes 37 us
+    }
+#endif
+}
+
+// Send a command
+void lcd_command(unsigned char cmd) {
+    lcd_write(cmd, 0);
+}
+
+// Send a character at the cursor
+void lcd_char(char dat) {
+    lcd_write((unsigned char)dat, 1);
+}
+
+// Send a string at the cursor
+void lcd_string(const char *msg) {
+    while (*msg != 0) {
+        lcd_char(*msg++);
+    }
+}
+
+// Send a string at row 1-2, column pos, straight to the LCD. The shadow buffer does not know
+// about it, so the next flush may overwrite it.
+void lcd_string_xy(unsigned char row, unsigned char pos, const char *msg) {
+    lcd_command(((row <= 1) ? 0x80 : 0xC0) | (pos & 0x0F));
+    lcd_string(msg);
+}
+
+// Set up the pins and the LCD, clear the screen and the shadow buffer
+void lcd_init(void) {
+    timebase_delay_ms(15);         // Power on delay
+    LCD_DATA_TRIS &= LCD_DATA_KEEP;  // Data pins as outputs
+    LCD_CONTROL_TRIS = 0x00;       // RS, EN and RW as outputs
+    LCD_RS = 0;
+    LCD_RW = 0;
+
+    // Function set three times with fixed delays, the busy flag is not valid before this
+    LCD_DATA = (LCD_DATA & LCD_DATA_KEEP) | 0x30;
+    lcd_pulse();
+    timebase_delay_ms(5);
+    lcd_pulse();
+    __delay_us(100);
+    lcd_pulse();
+    __delay_us(100);
+#if LCD_4BIT_MODE
+    LCD_DATA = (LCD_DATA & LCD_DATA_KEEP) | 0x20;  // Switch to the 4-bit interface
+    lcd_pulse();
+    __delay_us(100);
+    lcd_command(0x28);             // 4-bit, 2 lines, 5x7 characters
+#else
+    lcd_command(0x38);             // 8-bit, 2 lines, 5x7 characters
+#endif
+    lcd_command(0x0C);             // Display on, cursor off
+    lcd_command(0x06);             // Increment cursor (shift cursor to right)
+    lcd_command(0x01);             // Clear display screen
+
+    memset(lcdScreen, ' ', sizeof(lcdScreen));  // Screen was cleared to spaces
+    lcd_buffer_clear();
+    lcdFlushPos = 0;
+    lcdCursor = LCD_CURSOR_UNKNOWN;
+}
+
+// Clear the shadow buffer, the LCD follows on the next flushes
+void lcd_buffer_clear(void) {
+    memset(lcdShadow, ' ', sizeof(lcdShadow));
+}
+
+// Write a string into the shadow buffer at row 1-2, column pos. Text past the end of the row
+// is dropped.
+void lcd_buffer_string_xy(unsigned char row, unsigned char pos, const char *msg) {
+    char *cell = lcdShadow[(row <= 1) ? 0 : 1];
+    unsigned char col = pos & 0x0F;
+
+    while (*msg != 0 && col < LCD_COLS) {
+        cell[col++] = *msg++;
+    }
+}
+
+// Write value / 10^decimals right-aligned into a width character field of the shadow buffer
+// (Common/fmt.h). The field is cut at the end of the row.
+void lcd_buffer_fixed(unsigned char row, unsigned char pos, unsigned char width, long value, unsigned char decimals) {
+    unsigned char col = pos & 0x0F;
+
+    if (width > LCD_COLS - col) {
+        width = LCD_COLS - col;
+    }
+    fmt_fixed(&lcdShadow[(row <= 1) ? 0 : 1][col], width, value, decimals);
+}
+
+// Send the next changed character to the LCD. Returns 0 when the LCD is up to date.
+unsigned char lcd_flush_step(void) {
+    for (unsigned char n = 0; n < LCD_ROWS * LCD_COLS; n++) {
+        unsigned char cell = lcdFlushPos;
+        unsigned char row = cell / LCD_COLS;
+        unsigned char col = cell % LCD_COLS;
+
+        lcdFlushPos = (cell + 1) & (LCD_ROWS * LCD_COLS - 1);
+
+        if (lcdShadow[row][col] != lcdScreen[row][col]) {
+            if (lcdCursor != cell) {   // Cursor-set only when the cell is not the next one
+                lcd_command((row == 0 ? 0x80 : 0xC0) | col);
+            }
+            lcd_char(lcdShadow[row][col]);
+            lcdScreen[row][col] = lcdShadow[row][col];
+
+            // The address counter moves right, but not from the end of row 1 to row 2
+            lcdCursor = (col == LCD_COLS - 1) ? LCD_CURSOR_UNKNOWN : cell + 1;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Send every changed character, for places that may block
+void lcd_flush(void) {
+    while (lcd_flush_step());
+}
@@ -0,0 +1,74 @@
+/*
+ * File: lcd.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: HD44780 character LCD driver shared by the C projects, 8-bit or 4-bit interface.
+ *          The program writes text and numbers into a shadow buffer with lcd_buffer_*(), and the
+ *          main loop sends one changed character per lcd_flush_step() call, so a screen update
+ *          never blocks the loop for more than one transfer. The driver keeps a copy of what the
+ *          LCD shows and skips cells that did not change and cursor moves to the next cell.
+ *          Transfers wait on the busy flag (LCD_USE_BUSY_FLAG) or fixed worst-case delays.
+ *          The pins default to data on PORTB and RS/EN/RW on RD0-RD2; define LCD_RS, LCD_EN,
+ *          LCD_RW, LCD_DATA, LCD_DATA_TRIS, LCD_CONTROL_TRIS and LCD_BUSY for the whole build
+ *          to move them, like LCD_4BIT_MODE and LCD_USE_BUSY_FLAG. lcd_init() waits on the
+ *          Common/timebase.h tick.
+ */
+
+#ifndef LCD_H
+#define LCD_H
+
+#include <xc.h>
+
+//=============================================================================
+// LCD DEFINITIONS
+//=============================================================================
+#ifndef LCD_RS
+#define LCD_RS              LATD0           // Register Select
+#define LCD_EN              LATD1           // Enable
+#define LCD_RW              LATD2           // Read/Write (0 = write)
+#define LCD_DATA            LATB            // Data port
+#define LCD_DATA_TRIS       TRISB           // Data port direction
+#define LCD_CONTROL_TRIS    TRISD           // RS, EN and RW port direction, all outputs
+#define LCD_BUSY            PORTBbits.RB7   // D7 = busy flag when reading
+#endif
+
+#ifndef LCD_4BIT_MODE
+#define LCD_4BIT_MODE       0       // 1 = data on the high nibble only, 0 = 8-bit data
+#endif
+#ifndef LCD_USE_BUSY_FLAG
+#define LCD_USE_BUSY_FLAG   1       // 1 = poll the busy flag through RW, 0 = fixed worst-case delays
+#endif
+
+#if LCD_4BIT_MODE
+#define LCD_DATA_MASK       0xF0    // D7-D4 on the high nibble
+#define LCD_DATA_KEEP       0x0F    // Low nibble free for other uses
+#else
+#define LCD_DATA_MASK       0xFF    // D7-D0 on the whole port
+#define LCD_DATA_KEEP       0x00
+#endif
+
+#define LCD_BUSY_TIMEOUT    1000    // Busy-flag polls before giving up, at least 2 ms
+#define LCD_ROWS            2       // Shadow buffer size, 2x16 display (power of two cells)
+#define LCD_COLS            16
+#define LCD_CURSOR_UNKNOWN  0xFF    // LCD address counter not at a known cell
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void lcd_pulse(void);  // Latch the data with a pulse on EN
+void lcd_wait(void);  // Wait until the LCD can take the next transfer
+void lcd_write(unsigned char value, unsigned char rs);  // Send a byte to the command or data register
+void lcd_command(unsigned char cmd);  // Send a command
+void lcd_char(char dat);  // Send a character at the cursor
+void lcd_string(const char *msg);  // Send a string at the cursor
+void lcd_string_xy(unsigned char row, unsigned char pos, const char *msg);  // Send a string at row 1-2, column pos
+void lcd_init(void);  // Set up the pins and the LCD, clear the screen and the shadow buffer
+void lcd_buffer_clear(void);  // Clear the shadow buffer
+void lcd_buffer_string_xy(unsigned char row, unsigned char pos, const char *msg);  // Write a string into the shadow buffer
+void lcd_buffer_fixed(unsigned char row, unsigned char pos, unsigned char width, long value, unsigned char decimals);  // Write a number into the shadow buffer
+unsigned char lcd_flush_step(void);  // Send the next changed character, 0 when the LCD is up to date
+void lcd_flush(void);  // Send every changed character
+
+#endif /* LCD_H */
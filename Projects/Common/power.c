@@ -0,0 +1,39 @@
+/*
+ * File: power.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Idle, Sleep and Doze helpers (power.h).
+ */
+
+#include <xc.h>
+#include "power.h"
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Stop the core until an interrupt, peripherals keep running
+void power_idle(void) {
+    CPUDOZEbits.IDLEN = 1;  // SLEEP enters Idle
+    SLEEP();
+    NOP();                  // Executed after wake-up
+}
+
+// Stop the core and the system clock until a wake-up interrupt
+void power_sleep(void) {
+    CPUDOZEbits.IDLEN = 0;  // SLEEP enters Sleep
+    SLEEP();
+    NOP();
+}
+
+// Slow the core, full speed again while an interrupt runs (ROI) and slow again after it (DOE)
+void power_doze(unsigned char ratio) {
+    CPUDOZE = 0x40 | 0x20 | 0x10 | (ratio & 0x07);  // DOZEN, ROI, DOE, DOZE ratio
+}
+
+// Core back to full speed
+void power_doze_off(void) {
+    CPUDOZE = 0x00;
+}
@@ -0,0 +1,91 @@
+/*
+ * File: power.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Low power helpers shared by the C projects.
+ *          Idle stops the core but keeps the system clock, so timers, PWM, IOC and the ADC keep
+ *          running and any enabled interrupt wakes it. Sleep also stops the system clock; only
+ *          LFINTOSC/ADCRC clocked peripherals, IOC and INT0 can wake it. Doze slows the core
+ *          while the peripherals stay at full speed. Unused modules are switched off with the
+ *          PMD registers, which also resets their registers, so do that before any setup.
+ */
+
+#ifndef POWER_H
+#define POWER_H
+
+#include <xc.h>
+#include <stdbool.h>
+
+//=============================================================================
+// MODULE DISABLE DEFINITIONS
+//=============================================================================
+
+// PMD0-PMD7 values for POWER_MODULES_OFF(), a set bit switches that module off.
+// Define them before including this file in the module that calls it, modules not listed stay on.
+#ifndef POWER_PMD0
+#define POWER_PMD0          0x00    // SYSC FVR HLVD CRC SCAN NVM CLKR IOC
+#endif
+#ifndef POWER_PMD1
+#define POWER_PMD1          0x00    // SMT1 TMR6 TMR5 TMR4 TMR3 TMR2 TMR1 TMR0
+#endif
+#ifndef POWER_PMD2
+#define POWER_PMD2          0x00    // - DAC ADC - - CMP2 CMP1 ZCD
+#endif
+#ifndef POWER_PMD3
+#define POWER_PMD3          0x00    // PWM8 PWM7 PWM6 PWM5 CCP4 CCP3 CCP2 CCP1
+#endif
+#ifndef POWER_PMD4
+#define POWER_PMD4          0x00    // - - - NCO1 - CWG3 CWG2 CWG1
+#endif
+#ifndef POWER_PMD5
+#define POWER_PMD5          0x00    // - - - - - - - DSM1
+#endif
+#ifndef POWER_PMD6
+#define POWER_PMD6          0x00    // - - U2 U1 SPI2 SPI1 I2C2 I2C1
+#endif
+#ifndef POWER_PMD7
+#define POWER_PMD7          0x00    // - - DMA2 DMA1 CLC4 CLC3 CLC2 CLC1
+#endif
+
+//=============================================================================
+// DOZE DEFINITIONS
+//=============================================================================
+#define POWER_DOZE_1_2      0x00    // Core runs 1 of every 2 instruction cycles
+#define POWER_DOZE_1_8      0x02
+#define POWER_DOZE_1_32     0x04
+#define POWER_DOZE_1_256    0x07
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void power_idle(void);  // Stop the core until an interrupt, peripherals keep running
+void power_sleep(void);  // Stop the core and the system clock until a wake-up interrupt
+void power_doze(unsigned char ratio);  // Slow the core, full speed again while an interrupt runs
+void power_doze_off(void);  // Core back to full speed
+
+// Switch off the modules set in POWER_PMD0-7, call before setting up any module. A macro, so
+// the values come from the project that calls it and the library needs no per-project build.
+#define POWER_MODULES_OFF()         do {                        \
+        PMD0 = POWER_PMD0;                                      \
+        PMD1 = POWER_PMD1;                                      \
+        PMD2 = POWER_PMD2;                                      \
+        PMD3 = POWER_PMD3;                                      \
+        PMD4 = POWER_PMD4;                                      \
+        PMD5 = POWER_PMD5;                                      \
+        PMD6 = POWER_PMD6;                                      \
+        PMD7 = POWER_PMD7;                                      \
+    } while (0)
+
+// Idle unless work is already pending. Interrupts are held off around the check so an
+// interrupt that arrives just before SLEEP leaves its flag set and the core wakes at once.
+#define POWER_IDLE_UNLESS(work)     do {                        \
+        INTCON0bits.GIE = 0;        /* GIEH when IPEN = 1 */    \
+        if (!(work)) {                                          \
+            power_idle();                                       \
+        }                                                       \
+        INTCON0bits.GIE = 1;        /* Pending ISR runs now */  \
+    } while (0)
+
+#endif /* POWER_H */
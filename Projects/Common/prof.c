@@ -0,0 +1,82 @@
+/*
+ * File: prof.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Profiling ring buffer, worst cases and histograms (prof.h), linked into profiling
+ *          builds only.
+ */
+
+#include <xc.h>
+#include "prof.h"
+
+#ifdef PROF_ENABLE
+
+//=============================================================================
+// PROFILING STATE
+//=============================================================================
+static volatile ProfEvent profRing[PROF_RING_SIZE];  // Newest events, oldest overwritten
+static volatile unsigned char profHead = 0;          // Next slot written
+static volatile unsigned int profEnter[PROF_IDS];    // Stamp of the last enter of each section
+static volatile unsigned int profMax[PROF_IDS];      // Longest duration of each section
+static volatile unsigned int profHist[PROF_IDS][PROF_BUCKETS];  // Duration histograms, saturating
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Start Timer1 and the trace pin, call after POWER_MODULES_OFF()
+void prof_init(void) {
+    PMD1bits.TMR1MD = 0;           // Timer1 module on
+    PROF_LAT = 0;
+    PROF_TRIS = 0;                 // Trace pin output
+
+    T1CON = 0x00;                  // Timer1 off while configuring
+    T1CLK = PROF_T1CLK;
+    T1GCON = 0x00;                 // No gate, free running
+    TMR1H = 0x00;
+    TMR1L = 0x00;
+    T1CON = PROF_T1CON;
+}
+
+// Current Timer1 count. With 16-bit reads TMR1H is latched when TMR1L is read.
+unsigned int prof_stamp(void) {
+    unsigned char low = TMR1L;
+
+    return ((unsigned int)TMR1H << 8) | low;
+}
+
+// Record an enter or exit event, safe from the main loop and from either ISR priority
+void prof_record(unsigned char id, unsigned char exit) {
+    unsigned char gie = INTCON0bits.GIE;  // Already 0 inside a high-priority ISR
+    unsigned int stamp;
+    unsigned int duration;
+    unsigned char bucket = 0;
+
+    INTCON0bits.GIE = 0;
+    PROF_LAT ^= 1;                 // One edge per event on the trace pin
+    stamp = prof_stamp();
+
+    profRing[profHead].id = id | exit;
+    profRing[profHead].stamp = stamp;
+    profHead = (profHead + 1) & (PROF_RING_SIZE - 1);
+
+    if (!exit) {
+        profEnter[id] = stamp;
+    } else {
+        duration = stamp - profEnter[id];  // Wrap-safe up to 65535 counts
+        if (duration > profMax[id]) {
+            profMax[id] = duration;
+        }
+        while ((duration >>= 1) != 0) {  // Bucket = index of the highest set bit
+            bucket++;
+        }
+        if (profHist[id][bucket] != 0xFFFF) {
+            profHist[id][bucket]++;
+        }
+    }
+    INTCON0bits.GIE = gie;
+}
+
+#endif /* PROF_ENABLE */
@@ -0,0 +1,74 @@
+/*
+ * File: prof.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: On-target profiling hooks shared by the C projects. PROF_ENTER(id)/PROF_EXIT(id)
+ *          toggle a spare trace pin (RE0 unless PROF_LAT/PROF_TRIS are defined) for a logic
+ *          analyzer and record a Timer1 stamp into a RAM ring buffer. Every exit also updates
+ *          the worst case and a log2 histogram of the time since the matching enter.
+ *          Timer1 counts instruction cycles (Fosc/4, prescaler PROF_T1CKPS), so the 16-bit
+ *          durations wrap after 65536 << PROF_T1CKPS cycles. Read the ring and the histograms
+ *          in the debugger watch window or send them out from a debug build.
+ *          Without PROF_ENABLE (release builds) the macros compile to nothing and no RAM,
+ *          timer or pin is used; the project Makefile sets it for every module and links
+ *          prof.c with PROF=1. Define the project's ids (0 to PROF_IDS - 1) before use.
+ */
+
+#ifndef PROF_H
+#define PROF_H
+
+#include <xc.h>
+
+#ifdef PROF_ENABLE
+
+//=============================================================================
+// PROFILING DEFINITIONS
+//=============================================================================
+#ifndef PROF_LAT
+#define PROF_LAT            LATEbits.LATE0      // Trace pin output latch
+#define PROF_TRIS           TRISEbits.TRISE0    // Trace pin direction
+#endif
+#ifndef PROF_T1CKPS
+#define PROF_T1CKPS         0       // Timer1 prescaler code, 1:1 counts every instruction cycle
+#endif
+
+#define PROF_RING_SIZE      32      // Recorded enter/exit events (power of two)
+#define PROF_IDS            8       // Profiled code sections
+#define PROF_BUCKETS        16      // Bucket b counts durations of 2^b to 2^(b+1) - 1 counts
+#define PROF_EXIT_FLAG      0x80    // Set in ProfEvent.id for an exit
+
+#define PROF_T1CLK          0x01    // Timer1 clock source Fosc/4
+#define PROF_T1CON          (0x03 | (PROF_T1CKPS << 4))  // Timer1 on, 16-bit reads, CKPS
+
+// One ring buffer entry: 3 bytes
+typedef struct {
+    unsigned char id;      // Section id, PROF_EXIT_FLAG set for an exit
+    unsigned int stamp;    // Timer1 count
+} ProfEvent;
+
+//=============================================================================
+// PROFILING MACROS
+//=============================================================================
+#define PROF_INIT()         prof_init()
+#define PROF_ENTER(id)      prof_record((id), 0)
+#define PROF_EXIT(id)       prof_record((id), PROF_EXIT_FLAG)
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void prof_init(void);  // Start Timer1 and the trace pin, call after POWER_MODULES_OFF()
+unsigned int prof_stamp(void);  // Current Timer1 count
+void prof_record(unsigned char id, unsigned char exit);  // Record an enter or exit event
+
+#else
+
+// Release build: no profiling code, data or pin
+#define PROF_INIT()         ((void)0)
+#define PROF_ENTER(id)      ((void)0)
+#define PROF_EXIT(id)       ((void)0)
+
+#endif /* PROF_ENABLE */
+
+#endif /* PROF_H */
@@ -0,0 +1,48 @@
+/*
+ * File: publish.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Change-driven publish policy (publish.h).
+ */
+
+#include <stdbool.h>
+#include "timebase.h"
+#include "publish.h"
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Forget the last value, the next publish follows minGap from now. This gives a source that
+// was just restarted time to produce a fresh value.
+void publish_reset(Publish *p) {
+    p->stamp = timebase_millis();
+    p->primed = 0;
+}
+
+// Check if the rate cap has run out, costs one 16-bit compare
+bool publish_allowed(const Publish *p, const PublishConfig *c) {
+    return (unsigned int)(timebase_millis() - p->stamp) >= c->minGap;
+}
+
+// Check if value should be published now. If so it becomes the last published value and the
+// caller must publish it.
+bool publish_due(Publish *p, const PublishConfig *c, long value) {
+    unsigned int age = timebase_millis() - p->stamp;
+    long change = value - p->last;
+
+    if (age < c->minGap) {
+        return false;
+    }
+    if (p->primed && change < c->delta && change > -c->delta
+            && (c->maxAge == 0 || age < c->maxAge)) {
+        return false;              // Steady and recent enough
+    }
+
+    p->last = value;
+    p->stamp += age;               // Now, without reading the count again
+    p->primed = 1;
+    return true;
+}
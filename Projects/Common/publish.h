@@ -0,0 +1,44 @@
+/*
+ * File: publish.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Publish policy for values shown or sent on a change rather than on a fixed period.
+ *          A value is published when it moves by at least PublishConfig.delta from the last
+ *          published one, or when maxAge milliseconds have passed without a publish. The rate
+ *          is capped at one publish per minGap milliseconds, and a change that arrives while
+ *          the cap holds is published as soon as it runs out.
+ *          Times come from Common/timebase.h and are wrap-safe up to 65535 ms. Check
+ *          publish_allowed() first so the value only has to be computed when it can be used.
+ */
+
+#ifndef PUBLISH_H
+#define PUBLISH_H
+
+#include <stdbool.h>
+#include "timebase.h"
+
+//=============================================================================
+// PUBLISH DEFINITIONS
+//=============================================================================
+typedef struct {
+    long delta;            // Change from the last published value that publishes at once
+    unsigned int minGap;   // Shortest time between two publishes in ms (rate cap)
+    unsigned int maxAge;   // Longest time between two publishes in ms, 0 = no refresh
+} PublishConfig;
+
+typedef struct {
+    long last;             // Last published value
+    unsigned int stamp;    // timebase_millis() of the last publish or reset
+    unsigned char primed;  // 0 until the first publish after publish_reset()
+} Publish;
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void publish_reset(Publish *p);  // Forget the last value, publish once minGap has passed
+bool publish_allowed(const Publish *p, const PublishConfig *c);  // Check if the rate cap has run out
+bool publish_due(Publish *p, const PublishConfig *c, long value);  // Check and record a publish of value
+
+#endif /* PUBLISH_H */
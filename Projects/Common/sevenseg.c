@@ -0,0 +1,93 @@
+/*
+ * File: sevenseg.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Segment table, frame buffer and digit multiplexing (sevenseg.h).
+ */
+
+#include <xc.h>
+#include "sevenseg.h"
+
+//=============================================================================
+// 7-SEGMENT TABLE
+//=============================================================================
+
+// Segment patterns for 0-F followed by the symbols
+const unsigned char seg7_table[18] = {
+    SEG7_A | SEG7_B | SEG7_C | SEG7_D | SEG7_E | SEG7_F,           // 0
+    SEG7_B | SEG7_C,                                               // 1
+    SEG7_A | SEG7_B | SEG7_D | SEG7_E | SEG7_G,                    // 2
+    SEG7_A | SEG7_B | SEG7_C | SEG7_D | SEG7_G,                    // 3
+    SEG7_B | SEG7_C | SEG7_F | SEG7_G,                             // 4
+    SEG7_A | SEG7_C | SEG7_D | SEG7_F | SEG7_G,                    // 5
+    SEG7_A | SEG7_C | SEG7_D | SEG7_E | SEG7_F | SEG7_G,           // 6
+    SEG7_A | SEG7_B | SEG7_C,                                      // 7
+    SEG7_A | SEG7_B | SEG7_C | SEG7_D | SEG7_E | SEG7_F | SEG7_G,  // 8
+    SEG7_A | SEG7_B | SEG7_C | SEG7_D | SEG7_F | SEG7_G,           // 9
+    SEG7_A | SEG7_B | SEG7_C | SEG7_E | SEG7_F | SEG7_G,           // A
+    SEG7_C | SEG7_D | SEG7_E | SEG7_F | SEG7_G,                    // b
+    SEG7_A | SEG7_D | SEG7_E | SEG7_F,                             // C
+    SEG7_B | SEG7_C | SEG7_D | SEG7_E | SEG7_G,                    // d
+    SEG7_A | SEG7_D | SEG7_E | SEG7_F | SEG7_G,                    // E
+    SEG7_A | SEG7_E | SEG7_F | SEG7_G,                             // F
+    0,                                                             // Blank
+    SEG7_G                                                         // Minus
+};
+
+//=============================================================================
+// DRIVER STATE
+//=============================================================================
+static volatile unsigned char sevensegFrame[SEVENSEG_MAX_DIGITS];  // Segment pattern of each digit
+static unsigned char sevensegSelect[SEVENSEG_MAX_DIGITS];  // RA bit mask of each digit
+static unsigned char sevensegMask = 0;        // All select pins
+static unsigned char sevensegDigits = 0;      // Digits in use
+static unsigned char sevensegActive = 0;      // Digit shown now, sevenseg_refresh() only
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Set up the segment and select pins with every digit blank. select[i] is the PORTA bit mask
+// that turns digit i on, digits is at most SEVENSEG_MAX_DIGITS.
+void sevenseg_init(const unsigned char *select, unsigned char digits) {
+    unsigned char i;
+
+    sevensegMask = 0;
+    for (i = 0; i < digits; i++) {
+        sevensegSelect[i] = select[i];
+        sevensegFrame[i] = 0;
+        sevensegMask |= select[i];
+    }
+    sevensegDigits = digits;
+    sevensegActive = 0;
+
+    ANSELD = 0x00;
+    LATD = 0x00;
+    TRISD = 0x00;                  // Segments as outputs
+    ANSELA &= ~sevensegMask;
+    LATA &= ~sevensegMask;         // All digits off
+    TRISA &= ~sevensegMask;
+    if (digits == 1) {
+        LATA |= sevensegMask;      // One digit stays selected
+    }
+}
+
+// Put a segment pattern in the frame buffer, a single digit shows it at once
+void sevenseg_set(unsigned char digit, unsigned char pattern) {
+    sevensegFrame[digit] = pattern;
+    if (sevensegDigits == 1) {
+        LATD = pattern;
+    }
+}
+
+// Show the next digit of the frame buffer, call every 1 ms from a timer interrupt
+void sevenseg_refresh(void) {
+    unsigned char digit = sevensegActive;
+
+    LATA &= ~sevensegMask;         // All digits off before the segments change, no ghosting
+    LATD = sevensegFrame[digit];
+    LATA |= sevensegSelect[digit];
+    sevensegActive = (digit + 1 < sevensegDigits) ? digit + 1 : 0;
+}
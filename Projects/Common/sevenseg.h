@@ -0,0 +1,54 @@
+/*
+ * File: sevenseg.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Multiplexed 7-segment display driver shared by the C projects, common cathode digits.
+ *          Segments on PORTD, one digit select per display on PORTA. The program writes segment
+ *          patterns into a frame buffer with sevenseg_set() and sevenseg_refresh(), called every
+ *          1 ms from the tick interrupt, shows one digit per call. Only the select pins are
+ *          written on PORTA, the other pins keep their function. A single digit is written out at
+ *          once and stays selected, so it needs no refresh.
+ *          seg7_table[] turns a value into a segment pattern by direct indexing, like
+ *          _segment_table in Project_2.
+ *          Wiring: RD6 (a), RD5 (b), RD4 (c), RD3 (d), RD2 (e), RD1 (f), RD0 (g), RD7 (dp).
+ */
+
+#ifndef SEVENSEG_H
+#define SEVENSEG_H
+
+#include <xc.h>
+
+//=============================================================================
+// SEGMENT DEFINITIONS
+//=============================================================================
+#define SEG7_A      (1 << 6)    // RD6
+#define SEG7_B      (1 << 5)    // RD5
+#define SEG7_C      (1 << 4)    // RD4
+#define SEG7_D      (1 << 3)    // RD3
+#define SEG7_E      (1 << 2)    // RD2
+#define SEG7_F      (1 << 1)    // RD1
+#define SEG7_G      (1 << 0)    // RD0
+#define SEG7_DP     (1 << 7)    // RD7 (decimal point)
+
+// Symbol indexes after the hex digits
+#define SEG7_ERROR  0x0E        // 'E'
+#define SEG7_BLANK  0x10        // All segments off
+#define SEG7_MINUS  0x11        // '-'
+
+#define SEVENSEG_MAX_DIGITS 4   // Frame buffer size
+
+//=============================================================================
+// 7-SEGMENT TABLE
+//=============================================================================
+extern const unsigned char seg7_table[18];  // Patterns for 0-F followed by the symbols, in program memory
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void sevenseg_init(const unsigned char *select, unsigned char digits);  // Set up the pins, select[i] = RA bit mask of digit i
+void sevenseg_set(unsigned char digit, unsigned char pattern);  // Put a pattern in the frame buffer
+void sevenseg_refresh(void);  // Show the next digit, call every 1 ms from a timer interrupt
+
+#endif /* SEVENSEG_H */
@@ -0,0 +1,64 @@
+/*
+ * File: timebase.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Millisecond count, timeouts and delays (timebase.h).
+ */
+
+#include <xc.h>
+#include <stdbool.h>
+#include "power.h"
+#include "timebase.h"
+
+//=============================================================================
+// TIMEBASE STATE
+//=============================================================================
+volatile unsigned int timebaseMillis = 0;  // Milliseconds since start-up, written by timebase_tick() only
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Advance the millisecond count, call every 1 ms from a timer interrupt. The 16-bit increment
+// takes two instructions, so high-priority interrupts are held off for it: an ISR that reads
+// the count while preempting a low-priority tick (fsm_post() stamps) never sees half of it.
+void timebase_tick(void) {
+    unsigned char gie = INTCON0bits.GIEH;  // Already 0 inside a high-priority ISR
+
+    INTCON0bits.GIEH = 0;
+    timebaseMillis++;
+    INTCON0bits.GIEH = gie;
+}
+
+// Milliseconds since start-up, safe from the main loop
+unsigned int timebase_millis(void) {
+    unsigned int now;
+
+    do {
+        now = timebaseMillis;          // 16-bit read is two instructions, retry if the tick
+    } while (now != timebaseMillis);   // interrupt changed it in between
+    return now;
+}
+
+// Expire after at least ms milliseconds, one more tick is added for the part already gone
+void timeout_start(Timeout *t, unsigned int ms) {
+    t->due = timebase_millis() + ms + 1;
+}
+
+// Check if the timeout has run out (wrap-safe)
+bool timeout_expired(const Timeout *t) {
+    return (int)(timebase_millis() - t->due) >= 0;
+}
+
+// Wait at least ms milliseconds. Interrupt time does not stretch the wait, and the core idles
+// between ticks (a tick just before SLEEP adds at most 1 ms).
+void timebase_delay_ms(unsigned int ms) {
+    Timeout t;
+
+    timeout_start(&t, ms);
+    while (!timeout_expired(&t)) {
+        power_idle();
+    }
+}
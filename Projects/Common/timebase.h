@@ -0,0 +1,44 @@
+/*
+ * File: timebase.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Millisecond timebase shared by the C projects, replacing calibrated delay loops.
+ *          A free-running 16-bit millisecond count is advanced by timebase_tick(), called every
+ *          1 ms from the project's tick interrupt (Common/timer.h starts the Timer0 tick).
+ *          Timeouts are wrap-safe up to 32767 ms and need global interrupts on.
+ *          timebase_delay_ms() idles the core between ticks. timebase_tick() masks the
+ *          high-priority interrupts around the increment, so an ISR of either priority may read
+ *          timebaseMillis directly.
+ */
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <xc.h>
+#include <stdbool.h>
+
+//=============================================================================
+// TIMEBASE DEFINITIONS
+//=============================================================================
+// Non-blocking timeout: start it, then poll timeout_expired() from the main loop
+typedef struct {
+    unsigned int due;      // Millisecond count at which the timeout expires
+} Timeout;
+
+//=============================================================================
+// TIMEBASE STATE
+//=============================================================================
+extern volatile unsigned int timebaseMillis;  // Milliseconds since start-up, written by timebase_tick() only
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void timebase_tick(void);  // Advance the count, call every 1 ms from a timer interrupt
+unsigned int timebase_millis(void);  // Milliseconds since start-up, safe from the main loop
+void timeout_start(Timeout *t, unsigned int ms);  // Expire after at least ms milliseconds
+bool timeout_expired(const Timeout *t);  // Check if the timeout has run out
+void timebase_delay_ms(unsigned int ms);  // Wait at least ms milliseconds on the tick
+
+#endif /* TIMEBASE_H */
@@ -0,0 +1,40 @@
+/*
+ * File: timer.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Timer0 tick and Timer2 set-up (timer.h).
+ */
+
+#include <xc.h>
+#include "timer.h"
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Start the 1 ms tick on Timer0. Set the priority (IPR3bits.TMR0IP) before and enable global
+// interrupts after.
+void timer_tick_init(void) {
+    T0CON0 = 0x00;                 // Timer0 off, 8-bit mode, 1:1 postscaler
+    T0CON1 = TIMER_T0CON1;         // Fosc/4 clock, prescaler from the clock profile
+    TMR0L = 0x00;                  // Clear the counter
+    TMR0H = TIMER_T0PERIOD;        // Period match every 1 ms
+
+    PIR3bits.TMR0IF = 0;           // Clear interrupt flag
+    PIE3bits.TMR0IE = 1;           // Enable Timer0 interrupt
+
+    T0CON0 = 0x80;                 // Timer0 on
+}
+
+// Start Timer2 free running on Fosc/4, prescaler 2^ckps, period + 1 counts per postscaler
+// output. T2PR can be changed later, e.g. for a PWM tone.
+void timer2_init(unsigned char ckps, unsigned char period) {
+    T2CON = 0x00;                  // Timer2 off while configuring
+    T2CLKCON = TIMER_T2CLKCON;     // Fosc/4 clock
+    T2HLT = 0x00;                  // Free running, software gated
+    T2TMR = 0x00;
+    T2PR = period;
+    T2CON = TIMER_T2CON(ckps);     // Timer2 on
+}
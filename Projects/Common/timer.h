@@ -0,0 +1,37 @@
+/*
+ * File: timer.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Timer set-up shared by the C projects. timer_tick_init() starts the 1 ms Timer0
+ *          tick every project runs its timebase, debounce and display refresh from, and
+ *          timer2_init() starts Timer2 free running for a PWM tone or an ADC trigger. Both
+ *          timers count Fosc/4 with prescalers from the Common/clock.h start-up profile. The
+ *          tick interrupt routine stays in the project, which also picks its priority.
+ */
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <xc.h>
+#include "clock.h"
+
+//=============================================================================
+// TIMER DEFINITIONS
+//=============================================================================
+
+// Timer0 in 8-bit mode: Fosc/4 prescaled to 250 kHz by the clock profile, 250 counts = 1 ms
+#define TIMER_T0CON1        (0x40 | CLOCK_TICK_CKPS)    // CS = Fosc/4, synchronous, CKPS
+#define TIMER_T0PERIOD      CLOCK_TICK_PERIOD           // TMR0H period match value
+
+#define TIMER_T2CLKCON      0x01    // Timer2 clock source Fosc/4
+#define TIMER_T2CON(ckps)   (0x80 | ((ckps) << 4))      // Timer2 on, CKPS, 1:1 postscaler
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void timer_tick_init(void);  // Start the 1 ms Timer0 tick interrupt
+void timer2_init(unsigned char ckps, unsigned char period);  // Start Timer2 with a prescaler code and period
+
+#endif /* TIMER_H */
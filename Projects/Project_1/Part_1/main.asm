@@ -6,10 +6,13 @@
 ;	The program controls a heating, ventilation, and air conditioning (HVAC) system
 ;   	based on a reference temperature and a measured temperature.
 ;   	The program compares the temperatures and activates heating or cooling accordingly.
+;	The measured temperature is sampled once a second: Timer0 triggers the ADC while the
+;	core sleeps and the ADC interrupt wakes it. A hysteresis band stops the outputs from
+;	chattering around the reference, and each run is limited in length and followed by a rest.
 ;   	The temperatures are also converted to their decimal digits representations as  
 ;	required and also for displaying purpose, if required in the future.
 ;
-; Dependencies: NONE
+; Dependencies: Common/bcd.inc
 ; Compiler: 	MPLABX IDE v6.20
 ; Author: 	Huy Nguyen 
 ; OUTPUTS: 
@@ -17,6 +20,7 @@
 ;	PORTD2 Cooling Control with LED
 ;	
 ; INPUTS: 
+;	 RA0 (ANA0) MCP9701A temperature sensor (19.5 mV/C, 400 mV at 0 C)
 ;        REG 0x20 refTemp  - Reference temperature
 ;   	 REG 0x21 measTemp - Measured temperature
 ;	 REG 0x22 contReg  - Control Register
@@ -26,19 +30,37 @@
 ;  	V1.1: 03/09/2025 - function to handle negative measTemp
 ;	V1.2: 03/10/2025 - added conversion to decimal digits as required in R9 and R10
 ;	V1.3: 03/10/2025 - simplify the process of getting absolute value for negative inputs
+;	V1.4: 10/14/2026 - decimal digits from the fixed-cycle BCD8 macro (Common/bcd.inc) using the
+;	hardware multiplier, replaces the repeated subtraction division. Hundreds digits are now filled.
+;	V2.0: 10/14/2026 - closed-loop control: measTemp sampled by the ADC every second (Timer0 trigger,
+;	core asleep between samples), hysteresis band and run time limit on HEAT_ON/COOL_ON.
+;	V2.1: 10/14/2026 - clock from the Common/clock.inc profile (HFINTOSC, no crystal).
 ;---------------------------------------------
 ;
 #include "MyConfig.inc"
 #include <xc.inc>
+#include "../../Common/bcd.inc"
+#include "../../Common/clock.inc"
 ;
 ;---------------------------------------------
 ; PROGRAM INPUTS
 ;---------------------------------------------
 ;
-#define  measTempInput	0XFD ; this is the input value (R5)
 #define  refTempInput	15  ; this is the input value (R4)
 ;
 ;---------------------------------------------
+; Control settings
+;---------------------------------------------
+;
+HYST_BAND	EQU	1	; Outputs start when measTemp is more than this far from refTemp (C)
+MAX_ON_SAMPLES	EQU	240	; Longest heating or cooling run (samples = seconds)
+MIN_OFF_SAMPLES	EQU	60	; Rest after every run (samples = seconds)
+SENSOR_OFFSET	EQU	20	; ADRESH at 0 C: 400 mV / 19.5 mV per count (VDD = 5 V, 8-bit)
+SENSOR_RAW_MAX	EQU	147	; ADRESH for 127 C, higher readings are clamped
+CONT_HEAT	EQU	0x01	; contReg values
+CONT_COOL	EQU	0x02
+;
+;---------------------------------------------
 ; Output Register definitions (R6) 
 ;---------------------------------------------
 ;
@@ -55,6 +77,15 @@ measTemp	EQU	0x21
 contReg 	EQU	0x22	
 ;
 ;---------------------------------------------
+; Control loop registers
+;---------------------------------------------
+;
+tempErr		EQU	0x23	; measTemp - refTemp (saturated)
+tempMag		EQU	0x24	; |tempErr| while below the reference
+onCount		EQU	0x25	; Samples the current output has been on
+restCount	EQU	0x26	; Samples left of the rest after a run
+;
+;---------------------------------------------
 ; Data Register Definitions
 ;---------------------------------------------
 ; for requiments - R9
@@ -67,11 +98,6 @@ measTemp_dec1	EQU 	0x70
 measTemp_dec10	EQU 	0x71
 measTemp_dec100 EQU 	0x72
  
-;---------------------------------------------
-; Temporary registers used for HEX to decimal conversion operations
-;---------------------------------------------
-temp_value	EQU     0x30	; divided number/remainder
-div_count	EQU     0x31	; division counter
 ;
 ;---------------------------------------------
 ; Main Program
@@ -86,85 +112,169 @@ div_count	EQU     0x31	; division counter
     ORG          0x20           ; Begin assembly at 0x20 (R7)
 	
 _start:	
+    CLOCK_INIT		; Clock profile first
     CLRF	TRISD	; initialize PORTD as output
+    CLRF	LATD	; Heating and cooling off
 	
     ; Load input values
     MOVLW	refTempInput
-    MOVWF	refTemp,1
-    MOVLW	measTempInput
-    MOVWF	measTemp,1
+    MOVWF	refTemp
+    CLRF	contReg
+    CLRF	onCount
+    CLRF	restCount
+    
+    RCALL	_setupADC	; Sensor on RA0, conversion triggered by Timer0
+    RCALL	_setupTimer	; 1 second sample period
 
 _main_1:	; Convert refTemp to decimal digits (R9)
-    MOVFF   refTemp, temp_value
-    CALL    _convert_to_decimal
-    MOVFF   temp_value, refTemp_dec1
-    MOVFF   div_count, refTemp_dec10
-    CLRF    refTemp_dec100,1
-
-_main_2:	; Convert measTemp to decimal digits (R10)
-    MOVFF   measTemp, temp_value
-    BTFSC   temp_value, 7, 1    ; Check if negative
-    NEGF    temp_value,1	; If negative, convert to absolute value
-    CALL    _convert_to_decimal
-    MOVFF   temp_value, measTemp_dec1
-    MOVFF   div_count, measTemp_dec10
-    CLRF    measTemp_dec100,1
-
-_isNegative:			; Check if measTemp is negative (bit 7 = 1)
-    BTFSC   measTemp,7,1        ; Skip next instruction if bit 7 is clear (measTemp > 0)
-    GOTO    HEAT_ON             ; measTemp < 0, run HEAT_ON
+    MOVLB   0
+    MOVF    refTemp, W
+    BCD8    refTemp_dec100, refTemp_dec10, refTemp_dec1
+
+_main_2:	; Sleep until the next sample is converted
+    SLEEP			; Timer0 triggers the ADC, the ADC interrupt wakes the core
+    NOP
+    BANKSEL PIR1
+    BTFSS   PIR1, 2		; ADIF set?
+    BRA	    _main_2		; Woken by something else, sleep again
+    BCF	    PIR1, 2		; Clear ADIF
+    
+    ; measTemp = ADRESH - SENSOR_OFFSET, clamped to 127 C
+    BANKSEL ADRESH
+    MOVF    ADRESH, W, 1
+    MOVWF   measTemp
+    MOVLW   SENSOR_RAW_MAX
+    CPFSLT  measTemp		; skip next instruction if below the clamp
+    MOVWF   measTemp
+    MOVLW   SENSOR_OFFSET
+    SUBWF   measTemp, F
+    
+    ; Convert measTemp to decimal digits (R10)
+    MOVLB   0
+    MOVF    measTemp, W
+    BCD8S   measTemp_dec100, measTemp_dec10, measTemp_dec1	; Digits of the absolute value
 
 _main_3:   			; Compare measTemp to refTemp
-    MOVFF	measTemp, WREG
-    CPFSEQ	refTemp,1 	; if measTemp = refTemp skip next instruction 
-    GOTO	_compare	; measTemp ≠ refTemp, need to determine heating or cooling
+    MOVF    restCount, F
+    BZ	    _error		; No rest pending
+    DECF    restCount, F	; Outputs stay off until the rest is over
+    BRA	    _main_2
+
+_error:				; tempErr = measTemp - refTemp, saturated to -128..127
+    MOVF    refTemp, W
+    SUBWF   measTemp, W
+    BNOV    _error_done
+    BN	    _error_high		; Overflow flips the sign: N set means a large positive error
+    MOVLW   0x80
+    BRA	    _error_done
+_error_high:
+    MOVLW   0x7F
+_error_done:
+    MOVWF   tempErr
     
-    ; do nothing when measTemp = refTemp (R3)
-    CLRF	contReg,1   ; Set contReg to 0
-    BCF		LED1		; Turn off Heating
-    BCF		LED2		; Turn off Cooling
-    BRA		_main_2		; Return to _main_2 to update displays
+    MOVF    contReg, W
+    XORLW   CONT_HEAT
+    BZ	    _heating
+    MOVF    contReg, W
+    XORLW   CONT_COOL
+    BZ	    _cooling
+
+_compare:			; Outputs off: start one only outside the hysteresis band (R3)
+    BTFSS   tempErr, 7
+    BRA	    _compare_warm
+    MOVF    tempErr, W
+    NEGF    WREG		; W = refTemp - measTemp
+    MOVWF   tempMag
+    MOVLW   HYST_BAND
+    CPFSGT  tempMag 		; if tempMag > HYST_BAND skip next instruction
+    BRA	    _main_2		; Inside the band, keep waiting
+    GOTO    HEAT_ON		; measTemp < refTemp - HYST_BAND, so go to HEAT_ON (R2)
+_compare_warm:
+    MOVLW   HYST_BAND
+    CPFSGT  tempErr 		; if tempErr > HYST_BAND skip next instruction
+    BRA	    _main_2		; Inside the band, keep waiting
+    GOTO    COOL_ON		; measTemp > refTemp + HYST_BAND, so go to COOL_ON (R1)
 
-_compare:
-    MOVFF	measTemp, WREG  ; Reload measTemp into WREG
-    CPFSGT	refTemp,1 	; if refTemp > measTemp skip next instruction
-    GOTO	COOL_ON		; measTemp > refTemp, so go to COOL_ON (R1)
-    GOTO	HEAT_ON		; measTemp < refTemp, so go to HEAT_ON (R2)
+_heating:			; Heat until measTemp reaches refTemp
+    BTFSS   tempErr, 7
+    GOTO    OUTPUT_OFF
+    GOTO    _duty
+
+_cooling:			; Cool until measTemp drops to refTemp
+    BTFSC   tempErr, 7
+    GOTO    OUTPUT_OFF
+    MOVF    tempErr, F
+    BZ	    OUTPUT_OFF
+
+_duty:				; Output on: limit the length of the run
+    INCF    onCount, F
+    MOVLW   MAX_ON_SAMPLES
+    CPFSLT  onCount		; skip next instruction if onCount < MAX_ON_SAMPLES
+    GOTO    OUTPUT_OFF
+    BRA	    _main_2
 
 HEAT_ON:			; measTemp < refTemp, start heating process
-    MOVLW	0x01
-    MOVWF	contReg,1
+    MOVLW	CONT_HEAT
+    MOVWF	contReg
+    CLRF	onCount
     BCF		LED2		; Turn off Cooling
     BSF		LED1		; Turn on Heating
     BRA		_main_2		
 
 COOL_ON:			; measTemp > refTemp, start cooling process
-    MOVLW	0x02
-    MOVWF	contReg,1
+    MOVLW	CONT_COOL
+    MOVWF	contReg
+    CLRF	onCount
     BCF		LED1		; Turn off Heating
     BSF		LED2		; Turn on Cooling
     BRA		_main_2		
 
+OUTPUT_OFF:			; Reference reached or run too long, rest before the next run
+    CLRF	contReg		; Set contReg to 0
+    BCF		LED1		; Turn off Heating
+    BCF		LED2		; Turn off Cooling
+    MOVLW	MIN_OFF_SAMPLES
+    MOVWF	restCount
+    BRA		_main_2
+
 ;---------------------------------------------
-; Subroutine used to convert HEX value to decimal
-; by dividing the number's BCD by 10
+; Subroutines used to set up the sampling
 ;---------------------------------------------
-_convert_to_decimal:
-    CLRF    div_count, 1	
-    
-    MOVLW   10
-    CPFSLT  temp_value, 1   ; Skip next instruction if temp_value < 10
-    GOTO    _div_by_10
-    RETURN		    ; Return to caller, _main_1 or 2
-    
-_div_by_10:		    ; looping subtraction to perform division
-    MOVLW   10
-    SUBWF   temp_value,1    
-    INCF    div_count,1	    
-    
-    ; Check if we can subtract 10 again
-    CPFSLT  temp_value, 1   ; Skip next instruction if temp_value < 10
-    GOTO    _div_by_10	    ; loop back to subtraction operation
-    RETURN		    ; Return to caller, _convert_to decimal
+_setupADC:
+    BANKSEL	ANSELA
+    BSF		ANSELA, 0	; RA0 analog input
+    BANKSEL	TRISA
+    BSF		TRISA, 0
+    BANKSEL	ADPCH
+    CLRF	ADPCH, 1	; Channel ANA0
+    BANKSEL	ADREF
+    CLRF	ADREF, 1	; VDD and VSS references
+    BANKSEL	ADACT
+    MOVLW	0x02		; Auto-conversion trigger: Timer0
+    MOVWF	ADACT, 1
+    BANKSEL	ADCON0
+    MOVLW	0x90		; ADC on, single conversion, ADCRC clock (runs in Sleep), left justified
+    MOVWF	ADCON0, 1
+    BANKSEL	PIR1
+    BCF		PIR1, 2		; Clear ADIF
+    BANKSEL	PIE1
+    BSF		PIE1, 2		; ADIE: wakes the core, GIE stays off so no ISR runs
+    BANKSEL	CPUDOZE
+    BCF		CPUDOZE, 7, 1	; IDLEN = 0: SLEEP stops the core
+    RETURN
+
+_setupTimer:
+    ; Timer0: LFINTOSC (31 kHz) / 128 = 242 Hz, 8-bit period 242 counts = 1 second, runs in Sleep
+    BANKSEL	T0CON1
+    MOVLW	0x97		; CS = LFINTOSC, asynchronous, CKPS = 1:128
+    MOVWF	T0CON1, 1
+    BANKSEL	TMR0H
+    MOVLW	241
+    MOVWF	TMR0H, 1	; Period match value
+    CLRF	TMR0L, 1
+    BANKSEL	T0CON0
+    MOVLW	0x80		; Timer0 on, 8-bit mode, 1:1 postscaler
+    MOVWF	T0CON0, 1
+    RETURN
 
 END
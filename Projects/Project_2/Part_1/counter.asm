@@ -34,6 +34,8 @@
 ;	instead of case-switch approach for more efficient code.
 ;   V1.4: 03/18/2025 - Redefine inputs, SW_A and SW_B, to PORTA [1 : 0] in preparation for revising the code
 ;	and use PORTB to interface with  a 4x3 keypad.		  	
+;   V1.5: 10/14/2026 - Clock from the Common/clock.inc profile (HFINTOSC, no crystal), the
+;	delay loop count is derived from CLOCK_FREQ.
 ;
 ; Useful links: 
 ;    Datasheet: https://ww1.microchip.com/downloads/en/DeviceDoc/PIC18(L)F26-27-45-46-47-55-56-57K42-Data-Sheet-40001919G.pdf  
@@ -45,13 +47,14 @@
 ;---------------------
 #include "MyConfig.inc"
 #include <xc.inc>
+#include "../../Common/clock.inc"
 
 ;----------------------------------------------------------------
-; Delay loop Inputs to create ~ 0.5 second delay (8MHz clock speed) 
+; Delay loop Inputs to create ~ 0.5 second delay (High_loop follows CLOCK_FREQ)
 ;----------------------------------------------------------------
 Inner_loop  equ 	165		; loop count in decimal 
 Outer_loop  equ 	200
-High_loop   equ		5 
+High_loop   equ		CLOCK_FREQ / 792000	; 99000 cycles per pass, 5 at 4 MHz
 ;----------------------------------------------------------------
 ; Program Constants
 ;----------------------------------------------------------------
@@ -95,6 +98,7 @@ _segment_table:
     DB          0x47    ; F (aefg)     - 01000111
     
 _initialization: 
+    CLOCK_INIT				; Clock profile first
     RCALL	_setupPortD
     RCALL 	_setupPortA
     CLRF 	COUNT                  ; Initialize counter to 0 
@@ -36,19 +36,22 @@
 ;   V2.3: 03/20/2025 - Create shorter time delay loop for waiting for signal stabilization
 ;   V2.4: 03/20/2025 - Rework keypad scanning logic operations according to actual PORTB's hardware configuration
 ;   V2.5: 03/21/2025 - Expand keypad scanning operation to include all keys
+;   V2.6: 10/14/2026 - Clock from the Common/clock.inc profile (HFINTOSC, no crystal), the
+;	delay loop count is derived from CLOCK_FREQ.
 
 ;---------------------
 ; Initialization
 ;---------------------
 #include "MyConfig.inc"
 #include <xc.inc>
+#include "../../Common/clock.inc"
 
 ;----------------------------------------------------------------
-; Delay loop Inputs to create ~ 0.5 second delay (8MHz clock speed) 
+; Delay loop Inputs to create ~ 0.5 second delay (High_loop follows CLOCK_FREQ)
 ;----------------------------------------------------------------
 Inner_loop  equ     165     ; loop count in decimal 
 Outer_loop  equ     200
-High_loop   equ     5       ; Reduced for faster response
+High_loop   equ     CLOCK_FREQ / 792000	; 99000 cycles per pass, 5 at 4 MHz
 
 ;----------------------------------------------------------------
 ; Program Constants
@@ -112,6 +115,7 @@ _segment_table:
     DB          0x47    ; F (aefg)     - 01000111
     
 _initialization: 
+    CLOCK_INIT                ; Clock profile first
     RCALL   _setupPortD       ; Setup 7-segment display port
     RCALL   _setupPortB       ; Setup keypad port
     
@@ -13,6 +13,9 @@
 ;   - if switch B is depressed, the 7-segment decrement from the point where switch A
 ;   - stops.
 ;   - When both switches are depressed, the 7-segment will reset to 0
+;   Key presses are picked up by an interrupt-on-change ISR and queued, so none are lost
+;   while the main loop is in a delay. The core sleeps while nothing is pressed.
+;   Held switches and '*'/'#' repeat from a 10 ms timer tick, faster the longer they are held.
 ;
 ; Inputs:
 ;   Keypad connected to PORTB
@@ -50,29 +53,68 @@
 ;   V3.1: 03/22/2025 - Rework keypad and switches detection logic for better debouncing handling
 ;   V3.2: 03/24/2025 - Rework keypad and switches detection logic by adding state detection logic, 
 ;	and rework counting operation/flow for better debouncing handling
+;   V3.3: 10/14/2026 - Replace polled keypad scanning with a row interrupt-on-change ISR.
+;	Columns stay HIGH while idle, a row edge runs one fast scan and queues the key in a
+;	4 entry FIFO. Timer0 ends a press once the rows have been low for ~16 ms.
+;   V3.4: 10/14/2026 - Sleep while no key or switch is down, woken by the keypad rows or
+;	the switches (IOC). Unused modules are switched off with the PMD registers.
+;   V3.5: 10/14/2026 - Clock from the Common/clock.inc profile (HFINTOSC, no crystal), the
+;	delay loop count is derived from CLOCK_FREQ.
+;   V3.6: 10/14/2026 - Delays timed by Timer1 on MFINTOSC instead of counting loops, so they
+;	are exact at any clock profile and the keypad ISR no longer stretches them.
+;   V3.7: 10/14/2026 - Auto-repeat moved into a 10 ms Timer2 tick interrupt: the switches are
+;	debounced and sampled with '*'/'#' every tick, a hold repeats after 0.5 s and speeds up
+;	the longer it lasts. The main loop only applies the posted steps, so no edge is missed
+;	(fixes the E to 0 / 1 to F skipping on the switches).
 
 ;---------------------
 ; Initialization
 ;---------------------
 #include "MyConfig.inc"
 #include <xc.inc>
+#include "../../Common/clock.inc"
 ;----------------------------------------------------------------
-; Delay loop Inputs to create ~ 0.5 second delay (8MHz clock speed)
+; Delay timer: Timer1 on MFINTOSC (500 kHz) / 8 = 62.5 kHz, counts up to overflow
 ;----------------------------------------------------------------
-Inner_loop  equ     165     ; loop count in decimal 
-Outer_loop  equ     200    
-High_loop   equ     5       ; Reduced for faster response 
+LONG_DELAY  equ     65536 - 31250   ; 0.5 second preload
+;----------------------------------------------------------------
+; Tick timer: Timer2 on MFINTOSC (500 kHz) / 32 = 15.625 kHz, 156 counts = ~10 ms
+;----------------------------------------------------------------
+TICK_PERIOD     equ     155     ; T2PR period match value
+REPEAT_DELAY    equ     50      ; Ticks held before the first repeat (0.5 s)
+REPEAT_START    equ     25      ; First repeat period in ticks (250 ms)
+REPEAT_MIN      equ     6       ; Fastest repeat period in ticks (60 ms)
+ACCEL_STEPS     equ     4       ; Repeats before the period is halved
+DIR_NONE        equ     0       ; Repeat inputs: nothing pressed
+DIR_UP          equ     1       ; SW_A or '*'
+DIR_DOWN        equ     2       ; SW_B or '#'
+DIR_RESET       equ     3       ; Both switches
 ;----------------------------------------------------------------
 ; Program Constants
 ;----------------------------------------------------------------
-REG10   equ     0x10    ; inner loop address 
-REG11   equ     0x11    ; outer loop address 
-REG30   equ     0x30    ; high loop address 
 COUNT   equ     0x31    ; counter variable address 
 KEY     equ     0x32    ; current key pressed 
-TEMP    equ     0x33    ; temporary storage 
-LASTKEY equ     0x34    ; last key pressed for debouncing
-KEY_FLAG equ    0x35    ; flag to indicate key is being processed
+HELD    equ     0x36    ; scan code of the key held down, KEY_NONE when released (ISR)
+FIFO_HEAD equ   0x37    ; next free FIFO slot, written by the ISR only
+FIFO_TAIL equ   0x38    ; oldest queued key, written by _getKey only
+ISR_COL  equ    0x39    ; column bit being scanned by the ISR
+ISR_IDX  equ    0x3A    ; scan code being resolved by the ISR (column * 4 + row)
+ISR_ROWS equ    0x3B    ; row pins read by the ISR
+ISR_NEXT equ    0x3C    ; FIFO_HEAD after the push
+KEY_FIFO equ    0x40    ; 4 byte key FIFO (0x40 - 0x43)
+SW_LAST  equ    0x44    ; switch sample of the last tick (bit 0 = A, bit 1 = B, 1 = pressed)
+SW_STABLE equ   0x45    ; debounced switches, same sample two ticks in a row
+RPT_DIR  equ    0x46    ; repeat input seen on the last tick (DIR_ value)
+RPT_TIMER equ   0x47    ; ticks to the next repeat
+RPT_RATE equ    0x48    ; current repeat period in ticks
+RPT_STEPS equ   0x49    ; repeats at the current period
+T_DIR    equ    0x4A    ; repeat input of this tick
+STEP_UP  equ    0x4B    ; increments posted by the tick ISR
+STEP_DN  equ    0x4C    ; decrements posted by the tick ISR
+RESET_REQ equ   0x4D    ; reset posted by the tick ISR
+; Scan codes (column * 4 + row) of the repeating keys
+SCAN_STAR   equ     3       ; '*' column 1, row 4
+SCAN_HASH   equ     11      ; '#' column 3, row 4
 ;----------------------------------------------------------------
 ; Keypad Definitions and Constants
 ;----------------------------------------------------------------
@@ -85,6 +127,9 @@ KEY_FLAG equ    0x35    ; flag to indicate key is being processed
 #define ROW2    4       ; PORTB,4 
 #define ROW3    6       ; PORTB,6 
 #define ROW4    7       ; PORTB,7 
+COL_MASK    equ     0x07    ; RB0-RB2 columns
+ROW_MASK    equ     0xD8    ; RB3, RB4, RB6, RB7 rows
+FIFO_MASK   equ     0x03    ; FIFO index wrap (4 entries)
 ; Key values
 KEY_NONE    equ     0xFF    ; No key pressed 
 KEY_STAR    equ	    0x2A    ; '*' key - increment 
@@ -100,7 +145,22 @@ KEY_ZERO    equ     0x00    ; '0' key - reset
     
     ORG     0                   ; Reset vector 
     GOTO    _initialization
-    ORG     0020H               ; Begin assembly at 0020H 
+    
+    ; Interrupt vector table (IVTBASE = 0x0008), each entry holds the ISR address / 4
+    ORG     0x0016              ; IRQ 7: interrupt-on-change
+    DW      _iocVector >> 2
+    ORG     0x0046              ; IRQ 31: Timer0
+    DW      _tmr0Vector >> 2
+    ORG     0x004C              ; IRQ 34: Timer2
+    DW      _tmr2Vector >> 2
+    
+    ORG     0x0050              ; ISR entry points must be 4 byte aligned
+_iocVector:
+    GOTO    _keypadISR
+_tmr0Vector:
+    GOTO    _releaseISR
+_tmr2Vector:
+    GOTO    _tickISR
     
     ; Lookup table for 7-segment display patterns (0-9)
     ; Based on pin mapping: RD0 (g), RD1 (f), RD2 (e), RD3 (d), RD4 (c), RD5 (b), RD6 (a) 
@@ -123,7 +183,16 @@ _segment_table:
     DB          0x4F    ; E (adefg)    - 01001111
     DB          0x47    ; F (aefg)     - 01000111
     
+    ; Key values by scan code (column * 4 + row), placed right after the segment table at 0x110
+_key_table:
+    DB          0x01, 0x04, 0x07, KEY_STAR  ; Column 1: 1, 4, 7, *
+    DB          0x02, 0x05, 0x08, KEY_ZERO  ; Column 2: 2, 5, 8, 0
+    DB          0x03, 0x06, 0x09, KEY_HASH  ; Column 3: 3, 6, 9, #
+    
 _initialization:
+    CLOCK_INIT                ; Clock profile first
+    RCALL   _setupPower       ; Switch off unused modules first
+    RCALL   _setupTimer1      ; Delay timer
     RCALL   _setupPortD       ; Setup 7-segment display port
     RCALL   _setupPortA       ; Setup switch port
     RCALL   _setupPortB       ; Setup keypad port
@@ -131,8 +200,16 @@ _initialization:
     ; Initialize variables
     MOVLW   KEY_NONE
     MOVWF   KEY              ; Initialize KEY to "no key pressed"
-    MOVWF   LASTKEY          ; Initialize LASTKEY to "no key pressed"
-    CLRF    KEY_FLAG         ; Initialize KEY_FLAG to 0 (no key being processed)
+    MOVWF   HELD             ; No key held down
+    CLRF    FIFO_HEAD        ; Empty key FIFO
+    CLRF    FIFO_TAIL
+    CLRF    SW_LAST          ; Repeat engine idle, no steps posted
+    CLRF    SW_STABLE
+    CLRF    RPT_DIR
+    CLRF    STEP_UP
+    CLRF    STEP_DN
+    CLRF    RESET_REQ
+    RCALL   _setupInterrupts ; Start the keypad interrupts
     
     ; Clear counter to 0 and display it
     CLRF    COUNT            ; Initialize counter to 0
@@ -142,45 +219,28 @@ _initialization:
     RCALL   _loopDelay
     
 _main: 
-    RCALL   _resetColumns	; Reset column pins for next scan
-    RCALL   _scanKeypad		; Scan keypad and store result in KEY
-    CLRF    TEMP			; Clear temp register for switch state
-    
-    ; Check Switch A - store state in bit 0 of TEMP
-    BANKSEL PORTA
-    BTFSS   SW_A
-    BSF     TEMP, 0
-    
-    ; Check Switch B - store state in bit 1 of TEMP
-    BTFSS   SW_B
-    BSF     TEMP, 1
-    
-    ; Check combined switch states
-    MOVF    TEMP, W
-    BZ      _check_keypad      ; No switches pressed, proceed to keypad scanning logic
-    
-    ; Check if both switches are pressed (TEMP == 0x03)
-    XORLW   0x03
-    BZ      _reset     ; Both switches pressed, proceed to reset counter to 0
-    
-    ; Check if only Switch A is pressed (TEMP == 0x01)
-    MOVF    TEMP, W
-    XORLW   0x01
-    BZ      _SWA_only     ; Only Switch A pressed
-    
-    ; Check if only Switch B is pressed (TEMP == 0x02)
-    MOVF    TEMP, W
-    XORLW   0x02              
-    BZ      _SWB_only     ; Only Switch B pressed
+    ; Apply the steps posted by the tick interrupt first
+    MOVF    RESET_REQ, W
+    BZ      _main_up
+    CLRF    RESET_REQ
+    CLRF    STEP_UP            ; Steps taken before the reset are dropped
+    CLRF    STEP_DN
+    CLRF    COUNT              ; Both switches: reset counter to 0
+    RCALL   _display
+    GOTO    _main
     
-_SWA_only:
-    RCALL   _increment        
-    RCALL   _loopDelay
+_main_up:
+    MOVF    STEP_UP, W
+    BZ      _main_down
+    DECF    STEP_UP, F         ; Single instruction, safe against the ISR
+    RCALL   _increment
     GOTO    _main
     
-_SWB_only:
-    RCALL   _decrement         
-    RCALL   _loopDelay
+_main_down:
+    MOVF    STEP_DN, W
+    BZ      _check_keypad
+    DECF    STEP_DN, F
+    RCALL   _decrement
     GOTO    _main
     
 _validateCount:	       ; Subroutine to check if COUNT is a positive value
@@ -204,71 +264,11 @@ _reset_count_to_min:
     RETURN
     
 _check_keypad:
-    ; First check if a key is pressed
-    MOVF    KEY, W
-    XORLW   KEY_NONE
-    BZ      _no_key_pressed    ; No key pressed
-    
-    ; Check if we're already processing a key
-    MOVF    KEY_FLAG, F
-    BNZ     _continue_key_processing
-    
-    ; New key press detected - set the flag and apply debounce delay
-    MOVLW   1
-    MOVWF   KEY_FLAG           ; Set flag to indicate key processing
-    
-    ; Check if key is different from last key
-    MOVF    KEY, W
-    CPFSEQ  LASTKEY            ; Skip if KEY = LASTKEY
-    GOTO    _new_key_process   ; Handle new key press
-    
-    ; Same key being held down
-    GOTO    _key_held_down
-    
-_continue_key_processing:	; Key is already being processed
-    ; Check if key is still pressed
+    ; Digit keys set the counter directly, '*' and '#' are repeated by the tick interrupt
+    RCALL   _getKey            ; Take the next key from the ISR and store it in KEY
     MOVF    KEY, W
     XORLW   KEY_NONE
-    BZ      _key_released
-    
-    ; Key still held down - handle auto-repeat for special keys
-    MOVF    KEY, W
-    CPFSEQ  LASTKEY            ; Skip if KEY = LASTKEY
-    GOTO    _key_changed       ; Key changed while flag set
-    
-    ; Same key still held down
-    GOTO    _key_held_down
-    
-_no_key_pressed:
-    ; Reset key flag if no key is pressed
-    CLRF    KEY_FLAG
-    MOVLW   KEY_NONE
-    MOVWF   LASTKEY
-    GOTO    _main
-    
-_key_released:		     ; Key was released - reset flag
-    CLRF    KEY_FLAG
-    MOVLW   KEY_NONE
-    MOVWF   LASTKEY
-    GOTO    _main
-    
-_key_changed:		    ; Key changed while being processed - update LASTKEY  
-    MOVF    KEY, W
-    MOVWF   LASTKEY
-    GOTO    _main
-    
-_new_key_process:
-    ; Update LASTKEY for a new key press
-    MOVF    KEY, W
-    MOVWF   LASTKEY
-    
-    ; Process based on key value
-    XORLW   KEY_STAR
-    BZ      _key_star_first_press
-    
-    MOVF    KEY, W
-    XORLW   KEY_HASH
-    BZ      _key_hash_first_press
+    BZ      _idle              ; No key pressed
     
     MOVF    KEY, W
     XORLW   KEY_ZERO
@@ -277,60 +277,53 @@ _new_key_process:
     ; Check if key is a digit (1-9)
     MOVF    KEY, W
     SUBLW   0x09
-    BN      _main           ; Not a valid digit
-    
-    MOVF    KEY, W
-    BZ      _main           ; Key 0 already handled
+    BN      _main              ; '*' or '#'
     
     ; Key is 1-9, set counter directly
+    MOVF    KEY, W
     MOVWF   COUNT
     RCALL   _display
-    
-    ; Add debounce delay
-    RCALL   _shortDelay
-    GOTO    _main
-    
-_key_held_down:
-    ; Handle auto-repeat for special keys
-    MOVF    KEY, W
-    XORLW   KEY_STAR
-    BZ      _key_star_held
-    
-    MOVF    KEY, W
-    XORLW   KEY_HASH
-    BZ      _key_hash_held
-    GOTO    _main	; Other keys don't auto-repeat
-    
-_key_star_first_press:	    ; First press of star key - increment once with delay
-    RCALL   _increment
-    RCALL   _loopDelay     ; Longer delay for first press
-    GOTO    _main
-    
-_key_hash_first_press:	    ; First press of hash key - decrement once with delay
-    RCALL   _decrement
-    RCALL   _loopDelay     ; Longer delay for first press
-    GOTO    _main
-    
-_key_star_held:
-    RCALL   _increment
-    RCALL   _loopDelay      ; Regular delay for auto-repeat
-    GOTO    _main
-    
-_key_hash_held:
-    RCALL   _decrement
-    RCALL   _loopDelay      ; Regular delay for auto-repeat
     GOTO    _main
     
 _key_zero_pressed:
     CLRF    COUNT
     RCALL   _display
-    RCALL   _shortDelay
     GOTO    _main
     
-_reset:
-    CLRF    COUNT           ; Reset counter to 0
-    RCALL   _display
-    RCALL   _loopDelay	    ; Use loop delay for debouncing.
+_idle:
+    ; Nothing to do: Sleep until a row or switch edge when nothing is pressed, otherwise Idle
+    ; until the next tick. Interrupts are held off around the checks so an interrupt just
+    ; before SLEEP wakes the core at once.
+    BANKSEL INTCON0
+    BCF     INTCON0, 7         ; GIE off
+    MOVF    STEP_UP, W         ; Steps posted since the checks above
+    IORWF   STEP_DN, W
+    IORWF   RESET_REQ, W
+    BNZ     _idle_done
+    MOVF    FIFO_TAIL, W
+    CPFSEQ  FIFO_HEAD          ; Skip if the FIFO is empty
+    GOTO    _idle_done
+    BANKSEL CPUDOZE
+    BSF     CPUDOZE, 7         ; IDLEN = 1: Idle, the tick keeps running
+    MOVF    RPT_DIR, W         ; Repeat engine busy
+    IORWF   SW_LAST, W         ; Switch sample not settled
+    BNZ     _idle_sleep
+    MOVLW   KEY_NONE
+    CPFSEQ  HELD               ; Skip if no key is held down
+    GOTO    _idle_sleep
+    BANKSEL PORTA
+    BTFSS   SW_A               ; Switches are active-low
+    GOTO    _idle_sleep
+    BTFSS   SW_B
+    GOTO    _idle_sleep
+    BANKSEL CPUDOZE
+    BCF     CPUDOZE, 7         ; IDLEN = 0: full Sleep, woken by IOC
+_idle_sleep:
+    SLEEP
+    NOP
+_idle_done:
+    BANKSEL INTCON0
+    BSF     INTCON0, 7         ; GIE on, a pending interrupt runs now
     GOTO    _main
     
 _increment:
@@ -355,157 +348,236 @@ _decrement_done:
     RCALL   _display        ; Display updated count
     RETURN                  ; Return to caller, don't jump to _main
 
-_resetColumns:
-    BANKSEL LATB
-    ; Set all columns HIGH (active)
-    BSF     LATB, COL1
-    BSF     LATB, COL2
-    BSF     LATB, COL3
-    RETURN
-    
 ;----------------------------------------------------------------
-;---------------- Keypad Scanning Subroutine --------------------
+;---------------- Keypad Subroutines ----------------------------
 ;----------------------------------------------------------------
-_scanKeypad:
-    ; Initialize KEY to "no key pressed"
+_getKey:
+    ; Take the oldest queued press, KEY_NONE if the FIFO is empty
     MOVLW   KEY_NONE
     MOVWF   KEY
-    
-    ;-------------------------------------------
-    ; Scan Column 1
-    ;-------------------------------------------
-    BANKSEL LATB
-    ; Set Column 1 active (HIGH), others inactive (LOW)
-    BSF     LATB, COL1      ; Set C1 HIGH (active)
-    BCF     LATB, COL2      ; Set C2 LOW (inactive)
-    BCF     LATB, COL3      ; Set C3 LOW (inactive)
-    RCALL   _shortDelay     ; Small delay for signal stabilization
-	 
-    BANKSEL PORTB			; Explicitly selecting bank for PORTB before reading  
-_col1_row1:
-    ; Check Row 1
-    BTFSS   PORTB, ROW1
-    GOTO    _col1_row2
-    MOVLW   0x01            ; Key '1' pressed
-    MOVWF   KEY
-    RETURN
-    
-_col1_row2:
-    ; Check Row 2
-    BTFSS   PORTB, ROW2
-    GOTO    _col1_row3
-    MOVLW   0x04            ; Key '4' pressed
-    MOVWF   KEY
-    RETURN
-    
-_col1_row3:
-    ; Check Row 3
-    BTFSS   PORTB, ROW3
-    GOTO    _col1_row4
-    MOVLW   0x07            ; Key '7' pressed
-    MOVWF   KEY
+    MOVF    FIFO_TAIL, W
+    CPFSEQ  FIFO_HEAD          ; Skip if the FIFO is empty
+    GOTO    _getKey_queued
     RETURN
     
-_col1_row4:
-    ; Check Row 4
-    BTFSS   PORTB, ROW4
-    GOTO    _scan_col2
-    MOVLW   KEY_STAR        ; Key '*' pressed
+_getKey_queued:
+    LFSR    0, KEY_FIFO        ; Point to the oldest queued key
+    ADDWF   FSR0L, F           ; WREG = FIFO_TAIL
+    MOVFF   INDF0, KEY         ; Read the scan code before freeing its slot
+    INCF    FIFO_TAIL, F       ; Remove it from the FIFO
+    MOVLW   FIFO_MASK
+    ANDWF   FIFO_TAIL, F
+    
+    ; Translate the scan code to the key value
+    MOVLW   LOW(_key_table)
+    MOVWF   TBLPTRL
+    MOVLW   HIGH(_key_table)
+    MOVWF   TBLPTRH
+    CLRF    TBLPTRU
+    MOVF    KEY, W
+    ADDWF   TBLPTRL, F
+    BTFSC   STATUS, 0          ; Check if carry occurred
+    INCF    TBLPTRH, F
+    TBLRD*
+    MOVF    TABLAT, W
     MOVWF   KEY
     RETURN
-	
-    
-_scan_col2:
-    ;-------------------------------------------
-    ; Scan Column 2
-    ;-------------------------------------------
+
+;----------------------------------------------------------------
+;---------------- Keypad Interrupt Service Routines -------------
+;----------------------------------------------------------------
+; Row change: one fast scan with no delays. WREG, STATUS and BSR are
+; restored from the shadow registers by RETFIE 1, the ISR only uses FSR1.
+_keypadISR:
+    BANKSEL IOCAF
+    CLRF    IOCAF              ; Switch edges only wake the core
     BANKSEL LATB
-    ; Set Column 2 active (HIGH), others inactive (LOW)
-    BCF     LATB, COL1      ; Set C1 LOW (inactive)
-    BSF     LATB, COL2      ; Set C2 HIGH (active)
-    BCF     LATB, COL3      ; Set C3 LOW (inactive)
-    RCALL   _shortDelay     ; Small delay for signal stabilization
-      
-    BANKSEL PORTB			; Explicitly selecting bank for PORTB before reading   
-_col2_row1:
-    ; Check Row 1
-    BTFSS   PORTB, ROW1
-    GOTO    _col2_row2
-    MOVLW   0x02            ; Key '2' pressed
-    MOVWF   KEY
-    RETURN
-    
-_col2_row2:
-    ; Check Row 2
-    BTFSS   PORTB, ROW2
-    GOTO    _col2_row3
-    MOVLW   0x05            ; Key '5' pressed
-    MOVWF   KEY
-    RETURN
-    
-_col2_row3:
-    ; Check Row 3
-    BTFSS   PORTB, ROW3
-    GOTO    _col2_row4
-    MOVLW   0x08            ; Key '8' pressed
-    MOVWF   KEY
-    RETURN
-    
-_col2_row4:
-    ; Check Row 4
-    BTFSS   PORTB, ROW4
-    GOTO    _scan_col3
-    MOVLW   KEY_ZERO        ; Key '0' pressed
-    MOVWF   KEY
-    RETURN
-    
-_scan_col3:
-    ;-------------------------------------------
-    ; Scan Column 3
-    ;-------------------------------------------
+    MOVLW   0x01               ; Start with column 1
+    MOVWF   ISR_COL
+    CLRF    ISR_IDX
+_isr_scan:
+    MOVF    LATB, W
+    ANDLW   0xF8               ; Keep the non-column latches
+    IORWF   ISR_COL, W
+    MOVWF   LATB               ; Only this column HIGH
+    NOP                        ; Let the row pins settle
+    NOP
+    MOVF    PORTB, W
+    ANDLW   ROW_MASK
+    BNZ     _isr_found
+    MOVLW   4                  ; Next column
+    ADDWF   ISR_IDX, F
+    RLNCF   ISR_COL, F
+    BTFSS   ISR_COL, 3         ; Done after column 3
+    GOTO    _isr_scan
+    GOTO    _isr_exit          ; Key already released (bounce)
+    
+_isr_found:
+    ; Add the row number to the scan code, lowest row first
+    MOVWF   ISR_ROWS
+    BTFSC   ISR_ROWS, ROW1
+    GOTO    _isr_push
+    INCF    ISR_IDX, F
+    BTFSC   ISR_ROWS, ROW2
+    GOTO    _isr_push
+    INCF    ISR_IDX, F
+    BTFSC   ISR_ROWS, ROW3
+    GOTO    _isr_push
+    INCF    ISR_IDX, F
+    
+_isr_push:
+    MOVLW   KEY_NONE
+    CPFSEQ  HELD               ; Skip if this is a new press
+    GOTO    _isr_held          ; Bounce or second key of the same press
+    INCF    FIFO_HEAD, W
+    ANDLW   FIFO_MASK
+    MOVWF   ISR_NEXT
+    CPFSEQ  FIFO_TAIL          ; Skip if the FIFO is full, the press is dropped
+    GOTO    _isr_queue
+    GOTO    _isr_held
+_isr_queue:
+    LFSR    1, KEY_FIFO
+    MOVF    FIFO_HEAD, W
+    ADDWF   FSR1L, F
+    MOVF    ISR_IDX, W
+    MOVWF   INDF1              ; Queue the scan code
+    MOVF    ISR_NEXT, W
+    MOVWF   FIFO_HEAD
+_isr_held:
+    MOVF    ISR_IDX, W
+    MOVWF   HELD
+    
+_isr_exit:
     BANKSEL LATB
-    ; Set Column 3 active (HIGH), others inactive (LOW)
-    BCF     LATB, COL1      ; Set C1 LOW (inactive)
-    BCF     LATB, COL2      ; Set C2 LOW (inactive)
-    BSF     LATB, COL3      ; Set C3 HIGH (active)
-    RCALL   _shortDelay     ; Small delay for signal stabilization
-        
-    BANKSEL PORTB			; Explicitly selecting bank for PORTB before reading    
-_col3_row1:
-    ; Check Row 1
-    BTFSS   PORTB, ROW1
-    GOTO    _col3_row2
-    MOVLW   0x03            ; Key '3' pressed
-    MOVWF   KEY
-    RETURN
-    
-_col3_row2:
-    ; Check Row 2
-    BTFSS   PORTB, ROW2
-    GOTO    _col3_row3
-    MOVLW   0x06            ; Key '6' pressed
-    MOVWF   KEY
-    RETURN
-    
-_col3_row3:
-    ; Check Row 3
-    BTFSS   PORTB, ROW3
-    GOTO    _col3_row4
-    MOVLW   0x09            ; Key '9' pressed
-    MOVWF   KEY
-    RETURN
-    
-_col3_row4:
-    ; Check Row 4
-    BTFSS   PORTB, ROW4
-    GOTO    _no_key
-    MOVLW   KEY_HASH        ; Key '#' pressed
-    MOVWF   KEY
-    RETURN
+    MOVLW   COL_MASK
+    IORWF   LATB, F            ; Back to the idle state, all columns HIGH
+    NOP
+    NOP
+    BANKSEL IOCBF
+    CLRF    IOCBF              ; Drop the edges caused by the scan
+    ; Check the rows after clearing the flags so a release in between is not missed
+    BANKSEL PORTB
+    MOVF    PORTB, W
+    ANDLW   ROW_MASK
+    BANKSEL T0CON0
+    BZ      _isr_rows_low
+    BCF     T0CON0, 7          ; Key down: stop the release timer
+    RETFIE  1
+_isr_rows_low:
+    BANKSEL TMR0L
+    CLRF    TMR0L              ; Rows low: (re)start the release timer
+    BANKSEL T0CON0
+    BSF     T0CON0, 7
+    RETFIE  1
+
+; Timer0: the rows stayed low for a full period, the press is over
+_releaseISR:
+    BANKSEL PIR3
+    BCF     PIR3, 7            ; Clear TMR0IF
+    BANKSEL T0CON0
+    BCF     T0CON0, 7          ; One shot
+    BANKSEL PORTB
+    MOVF    PORTB, W
+    ANDLW   ROW_MASK
+    BNZ     _release_done      ; Pressed again, the IOC ISR restarts the timer
+    MOVLW   KEY_NONE
+    MOVWF   HELD
+_release_done:
+    RETFIE  1
+
+; Timer2 tick (~10 ms): debounce the switches and run the auto-repeat state machine.
+; Steps are only posted here (STEP_UP, STEP_DN, RESET_REQ), the main loop applies them.
+_tickISR:
+    BANKSEL PIR4
+    BCF     PIR4, 2            ; Clear TMR2IF
     
-_no_key:					; No key was pressed - reset all columns to active
-    RCALL   _resetColumns
-    RETURN
+    ; A switch sample counts once it is the same two ticks in a row
+    BANKSEL PORTA
+    COMF    PORTA, W           ; Pressed = 1
+    ANDLW   0x03
+    CPFSEQ  SW_LAST            ; Skip if it matches the last tick
+    BRA     _tick_sw_new
+    MOVWF   SW_STABLE
+_tick_sw_new:
+    MOVWF   SW_LAST
+    
+    ; Repeat input: the switch bits already match DIR_UP/DOWN/RESET, else '*' or '#' held
+    MOVF    SW_STABLE, W
+    BNZ     _tick_dir
+    MOVLW   SCAN_STAR
+    CPFSEQ  HELD
+    BRA     _tick_not_star
+    MOVLW   DIR_UP
+    BRA     _tick_dir
+_tick_not_star:
+    MOVLW   SCAN_HASH
+    CPFSEQ  HELD
+    BRA     _tick_not_hash
+    MOVLW   DIR_DOWN
+    BRA     _tick_dir
+_tick_not_hash:
+    MOVLW   DIR_NONE
+    
+_tick_dir:
+    MOVWF   T_DIR
+    CPFSEQ  RPT_DIR            ; Skip if the input is unchanged
+    BRA     _tick_changed
+    
+    ; Same input as the last tick: count down to the next repeat
+    MOVF    T_DIR, W
+    BZ      _tick_done         ; Nothing pressed
+    XORLW   DIR_RESET
+    BZ      _tick_done         ; Reset does not repeat
+    DECFSZ  RPT_TIMER, F
+    BRA     _tick_done
+    MOVFF   RPT_RATE, RPT_TIMER
+    INCF    RPT_STEPS, F
+    MOVLW   ACCEL_STEPS
+    CPFSEQ  RPT_STEPS          ; Skip after ACCEL_STEPS repeats at this period
+    BRA     _tick_step
+    CLRF    RPT_STEPS
+    MOVLW   REPEAT_MIN * 2
+    CPFSLT  RPT_RATE           ; Skip if halving would go below REPEAT_MIN
+    BRA     _tick_faster
+    BRA     _tick_step
+_tick_faster:
+    BCF     STATUS, 0          ; Halve the repeat period
+    RRCF    RPT_RATE, F
+    BRA     _tick_step
+    
+_tick_changed:
+    ; After a reset wait until everything is released, so letting go of one switch
+    ; does not count
+    MOVLW   DIR_RESET
+    CPFSEQ  RPT_DIR
+    BRA     _tick_new
+    MOVF    T_DIR, W
+    BNZ     _tick_done
+_tick_new:
+    ; New press (or release): one step now, repeats after REPEAT_DELAY
+    MOVF    T_DIR, W
+    MOVWF   RPT_DIR
+    BZ      _tick_done         ; Released
+    MOVLW   REPEAT_DELAY
+    MOVWF   RPT_TIMER
+    MOVLW   REPEAT_START
+    MOVWF   RPT_RATE
+    CLRF    RPT_STEPS
+    
+_tick_step:
+    ; Post one step for the main loop
+    MOVLW   DIR_RESET
+    CPFSEQ  RPT_DIR
+    BRA     _tick_count
+    SETF    RESET_REQ
+    BRA     _tick_done
+_tick_count:
+    BTFSC   RPT_DIR, 0         ; DIR_UP
+    INCF    STEP_UP, F
+    BTFSC   RPT_DIR, 1         ; DIR_DOWN
+    INCF    STEP_DN, F
+_tick_done:
+    RETFIE  1
     
 ;----------------------------------------------------------------
 ;---------- The Display Subroutine with Lookup Table ------------
@@ -538,32 +610,26 @@ _display:
 ;----------  The Delay Subroutines ------------------------------
 ;----------------------------------------------------------------
 _loopDelay:
-    MOVLW       Inner_loop
-    MOVWF       REG10
-    MOVLW       Outer_loop
-    MOVWF       REG11
-    MOVLW       High_loop
-    MOVWF       REG30
-_loop1:
-    DECF      REG10, F
-    BNZ       _loop1
-    MOVLW     Inner_loop 	; Re-initialize the inner loop for when the outer loop decrements.
-    MOVWF     REG10
-    DECF      REG11, F 		; outer loop
-    BNZ       _loop1
-    MOVLW     Outer_loop 	; Re-initialize the outer loop for when the high loop decrements.
-    MOVWF     REG11				
-    DECF      REG30, F		; high loop
-    BNZ       _loop1
-    RETURN
+    ; 0.5 second delay on Timer1
+    BANKSEL T1CON
+    BCF     T1CON, 0           ; Timer1 off while loading
+    MOVLW   HIGH(LONG_DELAY)
+    MOVWF   TMR1H
+    MOVLW   LOW(LONG_DELAY)
+    MOVWF   TMR1L
 
-; Shorter delay for debouncing (~255µs)
-_shortDelay:
-    MOVLW       255             
-    MOVWF       TEMP
-_shortLoop:
-    DECF        TEMP, F
-    BNZ         _shortLoop
+_timerDelay:
+    ; Run Timer1 from the preload until it overflows
+    BANKSEL PIR4
+    BCF     PIR4, 0            ; Clear TMR1IF
+    BANKSEL T1CON
+    BSF     T1CON, 0           ; Timer1 on
+    BANKSEL PIR4
+_timerWait:
+    BTFSS   PIR4, 0            ; Wait for TMR1IF
+    BRA     _timerWait
+    BANKSEL T1CON
+    BCF     T1CON, 0           ; Timer1 off
     RETURN
 	
 ;----------------------------------------------------------------
@@ -606,6 +672,93 @@ _setupPortB:
     
     RETURN
     
+_setupPower:
+    ; Modules switched off, only Timer0-2, NVM and IOC stay on
+    BANKSEL PMD0
+    MOVLW   0x7A               ; FVR, HLVD, CRC, SCAN, CLKR off
+    MOVWF   PMD0
+    MOVLW   0xF8               ; All timers except TMR0, TMR1 and TMR2, SMT1 off
+    MOVWF   PMD1
+    MOVLW   0x67               ; DAC, ADC, CMP1, CMP2, ZCD off
+    MOVWF   PMD2
+    MOVLW   0xFF               ; CCP1-4, PWM5-8 off
+    MOVWF   PMD3
+    MOVLW   0x17               ; CWG1-3, NCO1 off
+    MOVWF   PMD4
+    MOVLW   0x01               ; DSM1 off
+    MOVWF   PMD5
+    MOVLW   0x3F               ; UARTs, SPIs, I2Cs off
+    MOVWF   PMD6
+    MOVLW   0x3F               ; CLCs, DMAs off
+    MOVWF   PMD7
+    RETURN
+    
+_setupTimer1:
+    ; Delay timer: MFINTOSC 500 kHz, 1:8 prescaler, 16-bit reads, started by the delays
+    BANKSEL T1CLK
+    MOVLW   0x05               ; CS = MFINTOSC
+    MOVWF   T1CLK
+    BANKSEL T1CON
+    MOVLW   0x32               ; CKPS = 1:8, RD16, Timer1 off
+    MOVWF   T1CON
+    RETURN
+    
+_setupTimer2:
+    ; Tick timer: MFINTOSC 500 kHz, 1:32 prescaler, period match every ~10 ms
+    BANKSEL T2CON
+    CLRF    T2CON              ; Timer2 off while configuring
+    MOVLW   0x05               ; CS = MFINTOSC
+    MOVWF   T2CLKCON
+    CLRF    T2HLT              ; Free running, software gated
+    CLRF    T2TMR
+    MOVLW   TICK_PERIOD
+    MOVWF   T2PR
+    MOVLW   0xD0               ; Timer2 on, CKPS = 1:32, 1:1 postscaler
+    MOVWF   T2CON
+    RETURN
+    
+_setupInterrupts:
+    ; Timer0 release timer: LFINTOSC (31 kHz) / 2, 8-bit period 256 counts = ~16 ms, started by the ISR
+    BANKSEL T0CON0
+    CLRF    T0CON0             ; Timer0 off, 8-bit mode, 1:1 postscaler
+    MOVLW   0x91               ; CS = LFINTOSC, asynchronous, CKPS = 1:2
+    MOVWF   T0CON1
+    BANKSEL TMR0H
+    SETF    TMR0H              ; Period match value
+    CLRF    TMR0L
+    
+    ; Interrupt-on-change on both edges of the row pins
+    BANKSEL IOCBP
+    MOVLW   ROW_MASK
+    MOVWF   IOCBP
+    BANKSEL IOCBN
+    MOVWF   IOCBN
+    BANKSEL IOCBF
+    CLRF    IOCBF
+    
+    ; Interrupt-on-change on the switch presses, to wake from Sleep
+    BANKSEL IOCAN
+    MOVLW   0x03               ; RA0 and RA1 falling edge
+    MOVWF   IOCAN
+    BANKSEL IOCAF
+    CLRF    IOCAF
+    
+    RCALL   _setupTimer2       ; Auto-repeat tick
+    
+    BANKSEL PIR3
+    BCF     PIR3, 7            ; Clear TMR0IF
+    BANKSEL PIR4
+    BCF     PIR4, 2            ; Clear TMR2IF
+    BANKSEL PIE0
+    BSF     PIE0, 7            ; IOCIE
+    BANKSEL PIE3
+    BSF     PIE3, 7            ; TMR0IE
+    BANKSEL PIE4
+    BSF     PIE4, 2            ; TMR2IE
+    BANKSEL INTCON0
+    BSF     INTCON0, 7         ; GIE
+    RETURN
+    
 _setupPortA:
     BANKSEL	PORTA
     CLRF	PORTA 			; Init PORTA
@@ -16,9 +16,7 @@ extern "C" {
 
 // 'C' source line config statements
 
-// CONFIG1L
-#pragma config FEXTOSC = LP     // External Oscillator Selection (LP (crystal oscillator) optimized for 32.768 kHz; PFM set to low power)
-#pragma config RSTOSC = EXTOSC  // Reset Oscillator Selection (EXTOSC operating per FEXTOSC bits (device manufacturing default))
+// CONFIG1L: oscillator selection is in Common/clock.c with the clock profiles
 
 // CONFIG1H
 #pragma config CLKOUTEN = OFF   // Clock out Enable bit (CLKOUT function is disabled)
@@ -75,8 +73,7 @@ extern "C" {
 
 #include <xc.h>
 
-#define _XTAL_FREQ 4000000                 // Fosc  frequency for _delay()  library
-#define FCY    _XTAL_FREQ/4
+#include "../../Common/clock.h"  // _XTAL_FREQ and FCY from the clock profile
 
 
 #ifdef	__cplusplus
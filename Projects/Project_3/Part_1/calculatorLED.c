@@ -25,6 +25,26 @@
  *    V1.4: 3/31/25 - Added support for zero inputs in operations
  *					- Disable all analogue functionality in preparation for integrating 7-segment display
  *	  V1.5: 4/1/25	- Modified to display results in binary format
+ *    V1.6: 10/14/26 - Keypad read by the shared IOC driver (Common/keypad.h), scanKeypad() only takes
+ *                     queued keys. Timer0 runs a 1 ms interrupt for the keypad release debounce.
+ *    V1.7: 10/14/26 - Key decode uses the shared const key map in Common/lookup.h.
+ *    V1.8: 10/14/26 - LEDs driven from the 1 ms Timer0 interrupt through ledSet()/ledBlink(). The negative
+ *                     sign bit blinks in the interrupt, so displayBinaryWithBlink() returns right away.
+ *    V1.9: 10/14/26 - scanKeypad() idles the core until the next tick or key press, unused modules are
+ *                     switched off with PMD (Common/power.h).
+ *    V2.0: 10/14/26 - Clock from the Common/clock.h profiles (HFINTOSC), the tick timer prescaler follows it.
+ *    V2.1: 10/14/26 - Delays run on the 1 ms tick (Common/timebase.h) and idle the core instead of
+ *                     counting cycles, so interrupts no longer stretch them.
+ *    V2.2: 10/14/26 - Profiling hooks (Common/prof.h) in tickISR, scanKeypad() and the main loop,
+ *                     compiled out unless PROF_ENABLE is defined.
+ *    V2.3: 10/14/26 - Input runs on the shared table-driven state machine (Common/fsm.h). keypad_ISR() and
+ *                     the tick post key and timer events, main() dispatches them and idles in between, so
+ *                     no state waits in a loop or a delay. The digit, operator, '#' and '*' rules are the
+ *                     calcTable[] rows.
+ *    V2.4: 10/14/26 - Common modules are compiled and linked separately (Makefile). keypad_init() takes
+ *                     postKey() as its press hook, the key map moved to Common/keypad.c and Timer0 is
+ *                     started by timer_tick_init() (Common/timer.h). The configuration bits are set
+ *                     in config.c.
  * Useful links:  
  *      Datasheet: https://ww1.microchip.com/downloads/en/DeviceDoc/PIC18(L)F26-27-45-46-47-55-56-57K42-Data-Sheet-40001919G.pdf 
  *      PIC18F Instruction Sets: https://onlinelibrary.wiley.com/doi/pdf/10.1002/9781119448457.app4 
@@ -38,44 +58,120 @@
 #include <stdbool.h>
 #include <math.h>
 #include <string.h>
-#include "C:/Program Files/Microchip/xc8/v3.00/pic/include/proc/pic18f47k42.h"
+
+#include "../../Common/keypad.h"
+
+// Modules switched off (Common/power.h), only Timer0, NVM and IOC stay on
+#define POWER_PMD0  0x7A    // FVR, HLVD, CRC, SCAN, CLKR off
+#define POWER_PMD1  0xFE    // All timers except TMR0, SMT1 off
+#define POWER_PMD2  0x67    // DAC, ADC, CMP1, CMP2, ZCD off
+#define POWER_PMD3  0xFF    // CCP1-4, PWM5-8 off
+#define POWER_PMD4  0x17    // CWG1-3, NCO1 off
+#define POWER_PMD5  0x01    // DSM1 off
+#define POWER_PMD6  0x3F    // UARTs, SPIs, I2Cs off
+#define POWER_PMD7  0x3F    // CLCs, DMAs off
+#include "../../Common/power.h"
 
 // Configuration bits - critical for proper operation
 #pragma config WDTE = OFF     // Watchdog Timer disabled
 #pragma config DEBUG = OFF    // Background debugger disabled
 
-#define _XTAL_FREQ 4000000    // Crystal frequency
-#define FCY _XTAL_FREQ/4
+#include "../../Common/clock.h"  // _XTAL_FREQ and FCY from the clock profile
+#include "../../Common/timebase.h"
+#include "../../Common/timer.h"
+#include "../../Common/fsm.h"
+
+// Profiling ids for Common/prof.h, hooks compile out unless PROF_ENABLE is defined
+#define PROF_FSM    0         // fsm_run() in main(), dispatch of the queued events
+#define PROF_TICK   1         // Timer0 interrupt
+#include "../../Common/prof.h"
 
 #define MAX_INPUT 0x63        // Maximum input is 99 in decimal
 #define MIN_INPUT 0x00        // Minimum input is 0 in decimal (changed from 1)
 
+#define LED_BLINK_MS   150    // On and off time of the blinking LEDs
+
+#define OPERATOR_SHOW_MS   500                  // D3 stays on this long after the operator key
+#define CLEAR_BLINK_MS     (5 * 2 * LED_BLINK_MS)  // D1 blinks 5 times after '*', all LEDs after a divide by zero
+
+// State machine events (FsmEvent.type), data is the key value for the key events
+typedef enum {
+    EVENT_DIGIT,         // 0-9
+    EVENT_OPERATOR,      // A-D
+    EVENT_CLEAR,         // '*'
+    EVENT_EQUALS,        // '#'
+    EVENT_TIMER          // fsm_timer_start() ran out
+} CalcEvent;
+
+// Calculator states (Fsm.state)
+typedef enum {
+    CALC_NUM1,           // Waiting for the first digit of the first number
+    CALC_NUM1_MORE,      // Second digit, operator or '#' after one digit
+    CALC_OPERATOR,       // Waiting for the operator
+    CALC_NUM2,           // Waiting for the first digit of the second number
+    CALC_NUM2_MORE,      // Second digit or '#' after one digit
+    CALC_EQUALS,         // Waiting for '#' to calculate
+    CALC_RESULT          // Result shown until '*'
+} CalcState;
+
 // Function prototypes
 void initialize();                 // Initialize all IO ports and hardware
-unsigned char scanKeypad();        // Keypad scanning 
-int getNum1();                     // Get the first number for the operation
-int getNum2();                     // Get the second number for the operation
-int getOperator();                 // Determine the arithmetic operation
+void initTickTimer();              // Start the 1 ms Timer0 keypad and LED interrupt
+void ledSet(unsigned char pattern);      // Show a steady LED pattern
+void ledBlink(unsigned char mask);       // Blink the LEDs in mask on top of the pattern
+void postKey(unsigned char code);        // Key press from keypad_ISR() to the state machine
+unsigned char firstDigit1(const FsmEvent *event);   // First digit of the first number
+unsigned char secondDigit1(const FsmEvent *event);  // Second digit of the first number
+unsigned char singleDigit1(const FsmEvent *event);  // First number ends after one digit
+unsigned char onOperator(const FsmEvent *event);    // Operator key
+unsigned char showNum2(const FsmEvent *event);      // D2 on after the operator was shown
+unsigned char firstDigit2(const FsmEvent *event);   // First digit of the second number
+unsigned char secondDigit2(const FsmEvent *event);  // Second digit of the second number
+unsigned char singleDigit2(const FsmEvent *event);  // Second number ends after one digit
+unsigned char onEquals(const FsmEvent *event);      // Calculate and show the result
+unsigned char onClear(const FsmEvent *event);       // '*' from any state
+unsigned char endBlink(const FsmEvent *event);      // Stop the '*' or error blink
 int doOperation(int num1, int num2, int operator);  // Performs arithmetic operation
 void displayBinary(int number);        // Convert and display number in binary on LEDs
 void displayBinaryWithBlink(int number); // Display binary with D8 blinking for negative numbers
-void displayResult();              // Display calculation result
 void resetCalculator();            // Reset calculator state
 void blinkLED(unsigned char pattern, int count, int delay_ms);  // Blink LEDs with pattern
 
 // Global variables to store input and calculation results
-int num11, num12;                 // First number's digits
-int num21, num22;                 // Second number's digits
+int num11;                        // First number's first digit
+int num21;                        // Second number's first digit
 int num1;                         // First number
 int num2;                         // Second number
 int operator;                     // Selected arithmetic operation
-unsigned char keyVal;             // Value of pressed key
 int result;                       // Calculation results 
-bool waitingForHashKey = false;   // Flag to indicate waiting for # key
-bool validInput = false;          // Flag to track if a valid input has been entered
+volatile unsigned char ledPattern = 0x00;    // Steady LED pattern, output by tickISR()
+volatile unsigned char ledBlinkMask = 0x00;  // LEDs toggled every LED_BLINK_MS by tickISR()
+
+// Calculator transitions, the first row matching the state and event is taken
+const FsmTransition calcTable[] = {
+    { CALC_NUM1,      EVENT_DIGIT,    firstDigit1,  CALC_NUM1_MORE },
+    { CALC_NUM1,      EVENT_TIMER,    endBlink,     FSM_SAME },
+    { CALC_NUM1_MORE, EVENT_DIGIT,    secondDigit1, CALC_OPERATOR },
+    { CALC_NUM1_MORE, EVENT_OPERATOR, onOperator,   CALC_NUM2 },      // One digit, then the operator
+    { CALC_NUM1_MORE, EVENT_EQUALS,   singleDigit1, CALC_OPERATOR },  // One digit, then '#'
+    { CALC_OPERATOR,  EVENT_OPERATOR, onOperator,   CALC_NUM2 },
+    { CALC_NUM2,      EVENT_DIGIT,    firstDigit2,  CALC_NUM2_MORE },
+    { CALC_NUM2,      EVENT_TIMER,    showNum2,     FSM_SAME },
+    { CALC_NUM2_MORE, EVENT_DIGIT,    secondDigit2, CALC_EQUALS },
+    { CALC_NUM2_MORE, EVENT_EQUALS,   singleDigit2, CALC_EQUALS },
+    { CALC_EQUALS,    EVENT_EQUALS,   onEquals,     CALC_RESULT },
+    { CALC_RESULT,    EVENT_TIMER,    endBlink,     FSM_SAME },
+    { FSM_ANY,        EVENT_CLEAR,    onClear,      CALC_NUM1 }
+};
+
+Fsm calc = { calcTable, sizeof(calcTable) / sizeof(calcTable[0]), CALC_NUM1 };
 
 
 void initialize() {
+    clock_init();  // Clock profile first, the delays and Timer0 depend on it
+    POWER_MODULES_OFF();  // Unused modules off before anything is set up
+    PROF_INIT();  // Trace pin and Timer1 cycle stamps in profiling builds
+    
     // Disable all analog functionality 
     ANSELA = 0x00; ANSELB = 0x00;  ANSELC = 0x00; ANSELD = 0x00;  ANSELE = 0x00;   
    
@@ -87,226 +183,181 @@ void initialize() {
     
     WPUB = 0x00;   // Disable all weak pull-ups on PORTB. Using pull-down resistor  on PORTB [4 : 7]
 
+    keypad_init(postKey);  // Row interrupt-on-change, columns idle HIGH, presses go to postKey()
+    initTickTimer();    // Start the keypad debounce and LED tick
+
     // Startup sequence to indicate system is working
     blinkLED(0xFF, 3, 250);  // Blink all LEDs 3 times
     blinkLED(0x01, 3, 250);  // Blink D1 3 times to indicate ready for input
-    LATD = 0x00;             // Turn off all LEDs after initialization
+    ledSet(0x00);            // Turn off all LEDs after initialization
 }
 
 
 void blinkLED(unsigned char pattern, int count, int delay_ms) {
     for (int i = 0; i < count; i++) {
-        LATD = pattern;
-        __delay_ms(500);
-        LATD = 0x00;
-        __delay_ms(500);
+        ledSet(pattern);
+        timebase_delay_ms(500);
+        ledSet(0x00);
+        timebase_delay_ms(500);
     }
 }
 
 
-unsigned char scanKeypad() {
-    unsigned char col, row;
-    unsigned char key = 0xFF;  // Default to no key pressed (0xFF)
-        
-    LATB &= 0xF0;  // Set all columns low 
+void ledSet(unsigned char pattern) { // Show a steady LED pattern, stops any blinking
+    ledBlinkMask = 0x00;
+    ledPattern = pattern;
+}
+
+
+void ledBlink(unsigned char mask) { // Blink the LEDs in mask, the other LEDs keep the pattern
+    ledBlinkMask = mask;
+}
+
+
+void initTickTimer() { // Start the 1 ms Timer0 interrupt (Common/timer.h)
+    timer_tick_init();
+    INTCON0bits.GIE = 1;         // Enable global interrupts
+}
+
+
+void __interrupt(irq(IRQ_TMR0), base(0x0008)) tickISR(void) { // 1 ms keypad and LED tick
+    static unsigned char blinkCount = 0;
+    static bool blinkOn = false;
     
-    for (col = 0; col < 4; col++) { // Scan each column        
-        LATB |= (1 << col);  // Set current column high
-                
-        __delay_ms(20);  // Wait for signal to stabilize
-               
-        for (row = 0; row < 4; row++) { // Read each row for this column
-            if (PORTB & (1 << (row + 4))) {                             
-                if (row == 0) { // Row 0 (physical row 1)
-                    switch (col) {
-                        case 0: key = 1; break;    // 1
-                        case 1: key = 2; break;    // 2
-                        case 2: key = 3; break;    // 3
-                        case 3: key = 0xA; break;  // A
-                    }
-                }               
-                else if (row == 1) { // Row 1 (physical row 2)
-                    switch (col) {
-                        case 0: key = 4; break;    // 4
-                        case 1: key = 5; break;    // 5
-                        case 2: key = 6; break;    // 6
-                        case 3: key = 0xB; break;  // B
-                    }
-                }                
-                else if (row == 2) { // Row 2 (physical row 3)
-                    switch (col) {
-                        case 0: key = 7; break;    // 7
-                        case 1: key = 8; break;    // 8
-                        case 2: key = 9; break;    // 9
-                        case 3: key = 0xC; break;  // C
-                    }
-                }                
-                else if (row == 3) { // Row 3 (physical row 4)
-                    switch (col) {
-                        case 0: key = 0xE; break;  // * (0xE)
-                        case 1: key = 0; break;    // 0
-                        case 2: key = 0xF; break;  // # (0xF)
-                        case 3: key = 0xD; break;  // D
-                    }
-                }                               
-                __delay_ms(20);  // Debouncing
-                
-                // Wait for key release with timeout
-                unsigned char timeout = 100;
-                while ((PORTB & (1 << (row + 4))) && (timeout > 0)) {
-                    __delay_ms(5);
-                    timeout--;
-                }                               
-                __delay_ms(20);  // Final debounce delay                                
-                LATB &= ~(1 << col);  // Set column back to low                                
-                return key;  // Return the key value
-            }
-        }                
-        LATB &= ~(1 << col);  // Set column back to low before trying next column
-    }    
-    return 0xFF;  // No key pressed
+    PROF_ENTER(PROF_TICK);
+    if (++blinkCount >= LED_BLINK_MS) { // Blink phase in hardware time, independent of the main loop
+        blinkCount = 0;
+        blinkOn = !blinkOn;
+    }
+    if (blinkOn) {
+        LATD = ledPattern | ledBlinkMask;
+    } else {
+        LATD = ledPattern & (unsigned char)~ledBlinkMask;
+    }
+    
+    keypad_tick();                      // Keypad release debounce
+    timebase_tick();                    // Millisecond count for the delays
+    fsm_tick();                         // State machine timer event
+    PIR3bits.TMR0IF = 0;                // Clear Timer0 interrupt flag
+    PROF_EXIT(PROF_TICK);
 }
 
 
-int getNum1() {
-    num11 = 0;
-    num12 = 0;
-    validInput = false;
+void postKey(unsigned char code) { // Called by keypad_ISR(), posts the key as a calculator event
+    unsigned char key = keypad_map[code];  // Key value for the physical layout
+    unsigned char type;
     
-    LATD = 0x00;  // All LEDs off, waiting for first number
-    while (1) {
-        keyVal = scanKeypad();       
-        if (keyVal == 0xFF) { // If no key pressed, continue scanning
-            continue;
-        }        
-        if (keyVal == 0xE) { // Check for reset (* key)
-            resetCalculator();
-            blinkLED(0x01, 5, 200);
-            return 0xFF; // Return special value to indicate reset
-        }       
-        if (keyVal <= 9) { // Get first digit (0-9)
-            num11 = keyVal;
-            validInput = true; // valid input detected
-            LATD = 0x01;  // D1 on to indicate first number mode
-            __delay_ms(500);
-            
-            while (1) { // Wait for second digit or operator
-                keyVal = scanKeypad();                
-                if (keyVal == 0xFF) { // If no key pressed, continue
-                    continue;
-                }                
-                if (keyVal <= 9) { // Check if second digit (0-9)
-                    num12 = keyVal;
-                    num1 = (num11 * 10) + num12;
-                   
-                    if (num1 > MAX_INPUT) { // Limit to valid range
-                        num1 = MAX_INPUT;
-                    }
-                    LATD = 0x01;   // turn D1 on to indicate first number mode
-                    return num1;
-                }          
-                else if (keyVal >= 0xA && keyVal <= 0xD) { // Check if operator (A-D)
-                    num1 = num11;
-                    operator = keyVal;
-                    return num1;
-                }                
-                else if (keyVal == 0xF) { // Check for hash key '#', determine if num1 is single digit input
-                    num1 = num11;
-                    return num1;
-                }                
-                else if (keyVal == 0xE) { // Check for reset (* key)
-                    resetCalculator();
-                    blinkLED(0x01, 5, 200);
-                    return 0xFF; // Return special value to indicate reset
-                }
-                __delay_ms(50);
-            }
-        }
-        __delay_ms(50);
+    if (key <= 9) {
+        type = EVENT_DIGIT;
+    } else if (key <= 0xD) {
+        type = EVENT_OPERATOR;
+    } else if (key == 0xE) {
+        type = EVENT_CLEAR;
+    } else {
+        type = EVENT_EQUALS;
+    }
+    fsm_post(type, key);
+}
+
+
+unsigned char firstDigit1(const FsmEvent *event) {
+    num11 = event->data;
+    ledSet(0x01);  // D1 on to indicate first number mode
+    return FSM_NEXT;
+}
+
+
+unsigned char secondDigit1(const FsmEvent *event) {
+    num1 = (num11 * 10) + event->data;
+    if (num1 > MAX_INPUT) { // Limit to valid range
+        num1 = MAX_INPUT;
     }
+    ledSet(0x04);  // D3 on waiting for operator key press
+    return FSM_NEXT;
 }
 
 
-int getOperator() {   
-    if (operator >= 0xA && operator <= 0xD) { // If operator was already set by getNum1
-        int temp = operator;
-        operator = 0; // Clear it
-        return temp;
-    }   
-    LATD = 0x04; // D3 on waiting for operator key press   
-    while (1) {
-        keyVal = scanKeypad();               
-        if (keyVal == 0xFF) { // If no key pressed, continue
-            continue;
-        }       
-        if (keyVal >= 0xA && keyVal <= 0xD) { // Check if valid operator (A-D)
-            LATD = 0x04; // Keep D3 on to indicate operator received
-            __delay_ms(500);
-            return keyVal;
-        }        
-        else if (keyVal == 0xE) { // Check for reset (* key)
-            resetCalculator();
-            blinkLED(0x01, 5, 200);
-            return 0; // Return 0 to indicate reset
-        }        
-        __delay_ms(50);
+unsigned char singleDigit1(const FsmEvent *event) { // '#' after one digit, num1 is single digit input
+    (void)event;
+    num1 = num11;
+    ledSet(0x04);  // D3 on waiting for operator key press
+    return FSM_NEXT;
+}
+
+
+unsigned char onOperator(const FsmEvent *event) {
+    if (calc.state == CALC_NUM1_MORE) { // Operator right after the first digit
+        num1 = num11;
     }
+    operator = event->data;
+    ledSet(0x04);  // D3 on to indicate operator received
+    fsm_timer_start(OPERATOR_SHOW_MS, EVENT_TIMER);  // Then D2 for the second number
+    return FSM_NEXT;
 }
 
 
-int getNum2() {
-    num21 = 0;
-    num22 = 0;
-    validInput = false;
+unsigned char showNum2(const FsmEvent *event) {
+    (void)event;
+    ledSet(0x02);  // D2 on waiting for second number
+    return FSM_NEXT;
+}
+
+
+unsigned char firstDigit2(const FsmEvent *event) {
+    num21 = event->data;
+    ledSet(0x02);  // Keep D2 on to indicate second number mode
+    return FSM_NEXT;
+}
+
+
+unsigned char secondDigit2(const FsmEvent *event) {
+    num2 = (num21 * 10) + event->data;
+    if (num2 > MAX_INPUT) {  // Limit to valid range
+        num2 = MAX_INPUT;
+    }
+    return FSM_NEXT;
+}
+
+
+unsigned char singleDigit2(const FsmEvent *event) { // '#' after one digit, num2 is single digit input
+    (void)event;
+    num2 = num21;
+    return FSM_NEXT;
+}
+
+
+unsigned char onEquals(const FsmEvent *event) {
+    (void)event;
+    result = doOperation(num1, num2, operator);  // Calculate result
     
-    LATD = 0x02; // D2 on waiting for second number
-    while (1) {
-        keyVal = scanKeypad();       
-        if (keyVal == 0xFF) { // If no key pressed, continue
-            continue;
-        }       
-        if (keyVal == 0xE) { // Check for reset (* key)
-            resetCalculator();
-            blinkLED(0x01, 5, 200);
-            return 0xFF; // Return special value to indicate reset
-        }       
-        if (keyVal <= 9) { // Get first digit (0-9)
-            num21 = keyVal;
-            validInput = true; // valid input detected
-            LATD = 0x02; // Keep D2 on to indicate second number mode
-            __delay_ms(500);            
-            while (1) { // Wait for second digit or hash key
-                keyVal = scanKeypad();               
-                if (keyVal == 0xFF) { // If no key pressed, continue
-                    continue;
-                }                
-                if (keyVal <= 9) { // Check if second digit (0-9)
-                    num22 = keyVal;
-                    num2 = (num21 * 10) + num22;
-                   
-                    if (num2 > MAX_INPUT) {  // Limit to valid range
-                        num2 = MAX_INPUT;
-                    }
-                    LATD = 0x02; // Keep D2 on to indicate second number mode
-                    waitingForHashKey = true;
-                    return num2;
-                }
-                // Check if hash key '#', determine if num1 is single digit input
-                else if (keyVal == 0xF) {
-                    num2 = num21;
-                    waitingForHashKey = true;
-                    return num2;
-                }                
-                else if (keyVal == 0xE) { // Check for reset (* key)
-                    resetCalculator();
-                    blinkLED(0x01, 5, 200);
-                    return 0xFF; // Return special value to indicate reset
-                }
-                __delay_ms(50);
-            }
-        }
-        __delay_ms(50);
+    ledSet(0x00); // Clear LEDs before displaying result
+    if (result == -1 && num2 == 0) { // Division by zero - indicate error
+        ledBlink(0xFF);  // Blink all LEDs, endBlink() stops it
+        fsm_timer_start(CLEAR_BLINK_MS, EVENT_TIMER);
+    } else {
+        displayBinaryWithBlink(result); // Negative results keep blinking D8 until '*'
+    }
+    return FSM_NEXT;
+}
+
+
+unsigned char onClear(const FsmEvent *event) {
+    (void)event;
+    bool midInput = (calc.state != CALC_RESULT);  // '*' after a result only clears it
+    
+    resetCalculator();
+    if (midInput) {
+        ledBlink(0x01);  // Blink D1 to indicate the reset, endBlink() stops it
+        fsm_timer_start(CLEAR_BLINK_MS, EVENT_TIMER);
     }
+    return FSM_NEXT;
+}
+
+
+unsigned char endBlink(const FsmEvent *event) {
+    (void)event;
+    ledSet(0x00);
+    return FSM_NEXT;
 }
 
 
@@ -331,9 +382,7 @@ int doOperation(int num1, int num2, int operator) {
             if (num2 != 0) {
                 result = num1 / num2;
             } else {
-                // Division by zero - indicate error
-                blinkLED(0xFF, 5, 200); // Blink all LEDs
-                return -1; // Error code for division by zero
+                return -1; // Error code for division by zero, onEquals() shows it
             }
             break;
         default:
@@ -352,7 +401,7 @@ void displayBinary(int number) {
             number = 0x7F; // Limit magnitude to 7 bits (to leave room for sign bit)
         }
     }  
-    LATD = (unsigned char)number;   // Display the binary representation directly
+    ledSet((unsigned char)number);   // Display the binary representation directly
 }
 
 
@@ -371,120 +420,34 @@ void displayBinaryWithBlink(int number) {
             number = 0xFF;
         }
     }    
-    if (is_negative) {       
-        unsigned int blink_counter = 0;     // Blink timing variables
-        const unsigned int BLINK_RATE = 5;  // Note: higher rate = slower blink
-        bool blink_state = false;
-        
-        while(1) {
-            // Toggle D8 based on blink counter to indicate negative
-            blink_counter++;
-            if (blink_counter >= BLINK_RATE) {
-                blink_state = !blink_state;
-                blink_counter = 0;
-            }
-            
-            // Display the binary value with blinking sign bit for negative numbers
-            if (blink_state) {               
-                LATD = (unsigned char)number | 0x80;  // D8 on as negative indicator
-            } else {                
-                LATD = (unsigned char)number & 0x7F;  // D8 off 
-            }
-                        
-            keyVal = scanKeypad();
-            if (keyVal == 0xE) { // Check for reset (* key)
-                resetCalculator();
-                return;
-            }                      
-            __delay_ms(25);  // Small delay for the blink effect
-        }
+    if (is_negative) { // D8 blinks as the negative indicator, the tick interrupt does the timing
+        ledSet((unsigned char)number & 0x7F);
+        ledBlink(0x80);
     } else { // Positive number - display normally in binary        
         displayBinary(number);
     }
 }
 
 
-void displayResult() {    
-    if (!waitingForHashKey) { // Waiting for # key
-        blinkLED(0x08, 3, 200); // Blink D4 to indicate waiting for '#'
-    }
-
-    // Wait for '#' key to complete calculation
-    while (1) {
-        keyVal = scanKeypad();        
-        if (keyVal == 0xFF) { // If no key pressed, continue
-            continue;
-        }
-        if (keyVal == 0xF) { // '#' key pressed            
-            result = doOperation(num1, num2, operator);  // Calculate result
-            
-            LATD = 0x00; // Clear LEDs before displaying result                        
-            if (result == -1 && num2 == 0) { // Handling division by zero
-                // Error has already been displayed in doOperation
-                while(1) {
-                    keyVal = scanKeypad();
-                    if (keyVal == 0xE) {
-                        resetCalculator();
-                        return;
-                    }
-                }
-            }           
-            else {             
-                displayBinaryWithBlink(result); // Display negative numbers                               
-                if (result >= 0) {
-                    while(1) {
-                        keyVal = scanKeypad();
-                        if (keyVal == 0xE) {
-                            resetCalculator();
-                            return;
-                        }
-                    }
-                }               
-            }
-            return;
-        }
-        else if (keyVal == 0xE) { // '*' key for reset
-            resetCalculator();
-            blinkLED(0x01, 5, 200);
-            return;
-        }
-        __delay_ms(50);
-    }
-}
-
-
 void resetCalculator() {
     // Reset all variables
     num1 = 0;
     num2 = 0;
     operator = 0;
-    waitingForHashKey = false;
-    validInput = false;
+    fsm_timer_stop();
          
-    LATD = 0x00;  // Clear display
+    ledSet(0x00);  // Clear display
 }
 
 
 void main() {    
     initialize();  // Initialize hardware
+    resetCalculator();  // Reset calculator state, calc starts in CALC_NUM1
         
-    while (1) { // Main program loop        
-        resetCalculator();  // Reset calculator state
-               
-        num1 = getNum1();   // Get first number
-        LATD = 0x01; // D1 on
-        if (num1 == 0xFF) continue; // Reset occurred
-                
-        operator = getOperator();  // Get operator
-        LATD = 0x04; // D3 on
-        if (operator == 0) continue; // Reset occurred
-               
-        num2 = getNum2();  // Get second number
-        LATD = 0x02; // D2 on
-        if (num2 == 0xFF) continue; // Reset occurred 
-                
-        displayResult();  // Display result
-                
-        __delay_ms(500);  // Short delay before next calculation
+    while (1) { // Main program loop, every key and timer event goes through calcTable[]
+        PROF_ENTER(PROF_FSM);
+        fsm_run(&calc);
+        PROF_EXIT(PROF_FSM);
+        POWER_IDLE_UNLESS(fsm_pending());  // Nothing to do until the next tick or key press
     }
 }
@@ -22,6 +22,27 @@
  *    V2.3: 4/4/25 - Reworked scanKeypad() to work with 7-segment
  *    V2.4: 4/6/25 - Reworked display functions and negative number display
  *    V2.5: 4/7/25 - Corrected num1 and negative number display
+ *    V2.6: 10/14/26 - Moved digit multiplexing into a Timer0 interrupt fed from a two-byte frame buffer.
+ *                     Display functions now only update the buffer and no longer busy-wait.
+ *    V2.7: 10/14/26 - Keypad read by the shared IOC driver (Common/keypad.h), scanKeypad() only takes
+ *                     queued keys. Timer0 interrupt also runs the keypad release debounce.
+ *    V2.8: 10/14/26 - Key decode and digit patterns use the shared const tables in Common/lookup.h.
+ *    V2.9: 10/14/26 - displayNumber() splits digits with the fixed-cycle bcd_div10_u8() (Common/bcd.h).
+ *    V3.0: 10/14/26 - scanKeypad() idles the core until the next tick or key press, unused modules are
+ *                     switched off with PMD (Common/power.h).
+ *    V3.1: 10/14/26 - Clock from the Common/clock.h profiles (HFINTOSC), the display timer prescaler follows it.
+ *    V3.2: 10/14/26 - Delays run on the 1 ms display tick (Common/timebase.h) and idle the core instead of
+ *                     counting cycles, so the refresh interrupt no longer stretches them.
+ *    V3.3: 10/14/26 - Profiling hooks (Common/prof.h) in displayISR, scanKeypad() and the main loop,
+ *                     compiled out unless PROF_ENABLE is defined.
+ *    V3.4: 10/14/26 - Input runs on the shared table-driven state machine (Common/fsm.h). keypad_ISR() and
+ *                     the display tick post key and timer events, main() dispatches them and idles in
+ *                     between. The operator flash and the divide-by-zero "E0" blink run on the timer
+ *                     event instead of delays, so a key is never missed while they show.
+ *    V3.5: 10/14/26 - Common modules are compiled and linked separately (Makefile). The frame buffer and
+ *                     digit multiplexing moved to the shared Common/sevenseg.c, keypad_init() takes
+ *                     postKey() as its press hook and Timer0 is started by timer_tick_init(). The
+ *                     configuration bits are set in config.c.
  */
  
 #include <xc.h>
@@ -31,14 +52,35 @@
 #include <stdbool.h>
 #include <math.h>
 #include <string.h>
-#include "C:/Program Files/Microchip/xc8/v3.00/pic/include/proc/pic18f47k42.h"
+
+#include "../../Common/keypad.h"
+#include "../../Common/sevenseg.h"
+
+// Modules switched off (Common/power.h), only Timer0, NVM and IOC stay on
+#define POWER_PMD0  0x7A    // FVR, HLVD, CRC, SCAN, CLKR off
+#define POWER_PMD1  0xFE    // All timers except TMR0, SMT1 off
+#define POWER_PMD2  0x67    // DAC, ADC, CMP1, CMP2, ZCD off
+#define POWER_PMD3  0xFF    // CCP1-4, PWM5-8 off
+#define POWER_PMD4  0x17    // CWG1-3, NCO1 off
+#define POWER_PMD5  0x01    // DSM1 off
+#define POWER_PMD6  0x3F    // UARTs, SPIs, I2Cs off
+#define POWER_PMD7  0x3F    // CLCs, DMAs off
+#include "../../Common/power.h"
+#include "../../Common/bcd.h"
 
 // Configuration bits - critical for proper operation
 #pragma config WDTE = OFF     // Watchdog Timer disabled
 #pragma config DEBUG = OFF    // Background debugger disabled
 
-#define _XTAL_FREQ 4000000    // Crystal frequency
-#define FCY _XTAL_FREQ/4
+#include "../../Common/clock.h"  // _XTAL_FREQ and FCY from the clock profile
+#include "../../Common/timebase.h"
+#include "../../Common/timer.h"
+#include "../../Common/fsm.h"
+
+// Profiling ids for Common/prof.h, hooks compile out unless PROF_ENABLE is defined
+#define PROF_FSM    0         // fsm_run() in main(), dispatch of the queued events
+#define PROF_TICK   1         // Timer0 interrupt
+#include "../../Common/prof.h"
 
 // Input range as specified in requirements
 #define MAX_INPUT 0x63        // Maximum input is 99 in decimal
@@ -48,15 +90,13 @@
 #define TENS_DIGIT_PIN    0   // RA0 - Controls tens digit (leftmost)
 #define UNITS_DIGIT_PIN   1   // RA1 - Controls units digit (rightmost)
 
-// 7-segment display segment definitions
-#define SEG_A   (1 << 6)    // RD6
-#define SEG_B   (1 << 5)    // RD5
-#define SEG_C   (1 << 4)    // RD4
-#define SEG_D   (1 << 3)    // RD3
-#define SEG_E   (1 << 2)    // RD2
-#define SEG_F   (1 << 1)    // RD1
-#define SEG_G   (1 << 0)    // RD0
-#define SEG_DP  (1 << 7)    // RD7 (decimal point)
+// Display refresh: the 1 ms Timer0 tick (Common/timer.h) shows one digit per period
+#define OPERATOR_SHOW_MS  150   // How long the operator is shown before "00" for num2
+#define ERROR_ON_MS       200   // Divide by zero "E0" on time
+#define ERROR_OFF_MS      100   // Divide by zero "E0" off time
+#define ERROR_BLINKS      5     // "E0" blinks before the result "00"
+
+// 7-segment segments and digit patterns are in Common/sevenseg.h, the key map in Common/keypad.h
 
 // Display mode definitions
 #define DISPLAY_RESET     0
@@ -65,80 +105,114 @@
 #define DISPLAY_NUM2      3
 #define DISPLAY_RESULT    4
 
+// State machine events (FsmEvent.type), data is the key value for the key events
+typedef enum {
+    EVENT_DIGIT,         // 0-9
+    EVENT_OPERATOR,      // A-D
+    EVENT_CLEAR,         // '*'
+    EVENT_EQUALS,        // '#'
+    EVENT_TIMER          // fsm_timer_start() ran out
+} CalcEvent;
+
+// Calculator states (Fsm.state)
+typedef enum {
+    CALC_NUM1,           // Waiting for the first digit of the first number
+    CALC_NUM1_MORE,      // Second digit, operator or '#' after one digit
+    CALC_OPERATOR,       // Waiting for the operator
+    CALC_NUM2,           // Waiting for the first digit of the second number
+    CALC_NUM2_MORE,      // Second digit or '#' after one digit
+    CALC_EQUALS,         // Waiting for '#' to calculate
+    CALC_ERROR,          // Divide by zero "E0" blinking
+    CALC_RESULT          // Result shown until '*'
+} CalcState;
+
 // Function prototypes
 void initialize(void);                       // Initialize all IO ports and hardware
-unsigned char scanKeypad(void);              // Enhanced keypad scanning
-int getNum1(void);                           // Get the first number for operation
-int getNum2(void);                           // Get the second number for operation
-int getOperator(void);                       // Determine the arithmetic operation
+void initDisplayTimer(void);                 // Start the Timer0 display refresh interrupt
+void postKey(unsigned char code);            // Key press from keypad_ISR() to the state machine
+unsigned char firstDigit1(const FsmEvent *event);   // First digit of the first number
+unsigned char secondDigit1(const FsmEvent *event);  // Second digit of the first number
+unsigned char singleDigit1(const FsmEvent *event);  // First number ends after one digit
+unsigned char onOperator(const FsmEvent *event);    // Operator key
+unsigned char showNum2(const FsmEvent *event);      // "00" after the operator was shown
+unsigned char firstDigit2(const FsmEvent *event);   // First digit of the second number
+unsigned char secondDigit2(const FsmEvent *event);  // Second digit of the second number
+unsigned char singleDigit2(const FsmEvent *event);  // Second number ends after one digit
+unsigned char onEquals(const FsmEvent *event);      // Calculate and show the result
+unsigned char errorBlink(const FsmEvent *event);    // Next "E0" blink phase
+unsigned char onClear(const FsmEvent *event);       // '*' from any state
 int doOperation(int num1, int num2, int operator);  // Performs arithmetic operation
 void displayNumber(int number);              // Display number on 7-segment display
 void displayDigit(int digit, int position, bool dp); // Display single digit
-void refreshDisplay(int number);             // Continuously refresh display to maintain visibility
+void refreshDisplay(int number);             // Set the value shown by the display refresh interrupt
+void showOperator(int op);                   // Show operator until the next display update
+void showError(void);                        // Show "E0"
+void clearDisplay(void);                     // Blank both digits
 void blinkDisplay(int count, int delay_ms);  // Blink 7-segment display
-void displayResult(void);                    // Display calculation result
 void resetCalculator(void);                  // Reset calculator state
 void updateDisplay(int value, int mode);     // Update display based on current mode
 unsigned char encodeDigit(int digit);        // Encode digit to 7-segment pattern
+void __interrupt(irq(IRQ_TMR0), base(0x0008)) displayISR(void); // Display multiplexing interrupt
 
 // Global variables to store input and calculation results
-int num1_tens, num1_units;            // First number's digits
-int num2_tens, num2_units;            // Second number's digits
+int num1_tens;               // First number's first digit
+int num2_tens;               // Second number's first digit
 int num1;                    // First number
 int num2;                    // Second number
 int operator;                // Selected arithmetic operation
-unsigned char keyVal;        // Value of pressed key
 int result;                  // Calculation results
 int displayMode;             // Current display mode
-bool waitingForHashKey = false;  // Flag for waiting for # key
-bool validInput = false;     // Flag for valid input
 int currentDisplayValue = 0; // Currently displayed value
 bool isDisplayNegative = false; // Whether current display is negative
-
-// 7-segment display patterns for digits 0-9, errors, and blank
-// Each pattern represents segments a,b,c,d,e,f,g which maps to PORTD
-const unsigned char digitPatterns[] = {
-    SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F,         // 0
-    SEG_B | SEG_C,                                         // 1
-    SEG_A | SEG_B | SEG_G | SEG_E | SEG_D,                 // 2
-    SEG_A | SEG_B | SEG_C | SEG_D | SEG_G,                 // 3
-    SEG_F | SEG_G | SEG_B | SEG_C,                         // 4
-    SEG_A | SEG_F | SEG_G | SEG_C | SEG_D,                 // 5
-    SEG_A | SEG_F | SEG_G | SEG_C | SEG_D | SEG_E,         // 6
-    SEG_A | SEG_B | SEG_C,                                 // 7
-    SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F | SEG_G, // 8
-    SEG_A | SEG_B | SEG_C | SEG_D | SEG_F | SEG_G,         // 9
-    SEG_A | SEG_D | SEG_G,                                 // Error pattern (E)
-    0                                                      // Blank
-};
+unsigned char errorPhases = 0;  // "E0" on and off phases left in CALC_ERROR
+const unsigned char digitSelect[2] = {1 << TENS_DIGIT_PIN, 1 << UNITS_DIGIT_PIN}; // Frame buffer slots: tens [0] and units [1] digit
 
 // Special display patterns for operators
 const unsigned char operatorPatterns[] = {
-    SEG_F | SEG_E | SEG_A | SEG_B | SEG_C,                 // A (Addition)
-    SEG_F | SEG_E | SEG_G | SEG_C | SEG_D,                 // S (Subtraction alt)
-    SEG_A | SEG_F | SEG_E | SEG_D,                         // C (Multiplication)
-    SEG_B | SEG_C | SEG_D | SEG_E | SEG_G                  // D (Division)
+    SEG7_F | SEG7_E | SEG7_A | SEG7_B | SEG7_C,            // A (Addition)
+    SEG7_F | SEG7_E | SEG7_G | SEG7_C | SEG7_D,            // S (Subtraction alt)
+    SEG7_A | SEG7_F | SEG7_E | SEG7_D,                     // C (Multiplication)
+    SEG7_B | SEG7_C | SEG7_D | SEG7_E | SEG7_G             // D (Division)
+};
+
+// Calculator transitions, the first row matching the state and event is taken
+const FsmTransition calcTable[] = {
+    { CALC_NUM1,      EVENT_DIGIT,    firstDigit1,  CALC_NUM1_MORE },
+    { CALC_NUM1_MORE, EVENT_DIGIT,    secondDigit1, CALC_OPERATOR },
+    { CALC_NUM1_MORE, EVENT_OPERATOR, onOperator,   CALC_NUM2 },      // One digit, then the operator
+    { CALC_NUM1_MORE, EVENT_EQUALS,   singleDigit1, CALC_OPERATOR },  // One digit, then '#'
+    { CALC_OPERATOR,  EVENT_OPERATOR, onOperator,   CALC_NUM2 },
+    { CALC_NUM2,      EVENT_DIGIT,    firstDigit2,  CALC_NUM2_MORE },
+    { CALC_NUM2,      EVENT_TIMER,    showNum2,     FSM_SAME },
+    { CALC_NUM2_MORE, EVENT_DIGIT,    secondDigit2, CALC_EQUALS },
+    { CALC_NUM2_MORE, EVENT_EQUALS,   singleDigit2, CALC_EQUALS },
+    { CALC_EQUALS,    EVENT_EQUALS,   onEquals,     CALC_RESULT },    // CALC_ERROR on a divide by zero
+    { CALC_ERROR,     EVENT_TIMER,    errorBlink,   FSM_SAME },       // CALC_RESULT after the last blink
+    { FSM_ANY,        EVENT_CLEAR,    onClear,      CALC_NUM1 }
 };
 
-// Special display patterns
-#define PATTERN_E (SEG_A | SEG_F | SEG_G | SEG_E | SEG_D)  // 'E' for error
-#define PATTERN_MINUS (SEG_G)                              // '-' for negative indicator
-#define PATTERN_BLANK (0)                                  // Blank display
+Fsm calc = { calcTable, sizeof(calcTable) / sizeof(calcTable[0]), CALC_NUM1 };
 
 
 void initialize(void) {
+    clock_init();  // Clock profile first, the delays and Timer0 depend on it
+    POWER_MODULES_OFF();  // Unused modules off before anything is set up
+    PROF_INIT();  // Trace pin and Timer1 cycle stamps in profiling builds
+    
     // Disable all analog functionality
     ANSELA = 0x00; ANSELB = 0x00;  ANSELC = 0x00; ANSELD = 0x00; ANSELE = 0x00;
        
-    TRISA = 0xFC; // Configure PORTA: RA0-RA1 outputs (digit select)
     TRISB = 0xF0; // Configure PORTB: RB0-RB3 outputs (columns), RB4-RB7 inputs (rows)    
-    TRISD = 0x00; // Configure PORTD as all outputs (for 7-segment display segments)
 
     // Initialize all ports to known state
     LATA = 0x00; LATB = 0x00; LATC = 0x00; LATD = 0x00; LATE = 0x00;
+    sevenseg_init(digitSelect, 2); // RA0-RA1 digit select, PORTD segments, both digits blank
                   
     WPUB = 0x00;  // Disable weak pull-ups on PORTB
 
+    keypad_init(postKey);  // Row interrupt-on-change, columns idle HIGH, presses go to postKey()
+    initDisplayTimer(); // Start refreshing the display from the frame buffer
+
     // Set initial display mode
     displayMode = DISPLAY_RESET;
     currentDisplayValue = 0;
@@ -150,50 +224,81 @@ void initialize(void) {
 }
 
 
+void initDisplayTimer(void) { // Start the 1 ms Timer0 interrupt (Common/timer.h), one digit slot per period
+    timer_tick_init();
+    INTCON0bits.GIE = 1;         // Enable global interrupts
+}
+
+
+void __interrupt(irq(IRQ_TMR0), base(0x0008)) displayISR(void) { // Multiplex one digit per Timer0 period
+    PROF_ENTER(PROF_TICK);
+    sevenseg_refresh();                 // Alternate tens and units on every interrupt
+    
+    keypad_tick();                      // 1 ms keypad release debounce
+    timebase_tick();                    // Millisecond count for the delays
+    fsm_tick();                         // State machine timer event
+    
+    PIR3bits.TMR0IF = 0;                // Clear Timer0 interrupt flag
+    PROF_EXIT(PROF_TICK);
+}
+
+
 unsigned char encodeDigit(int digit) { // Encode digit to 7-segment pattern    
     if (digit >= 0xA && digit <= 0xD) {// Handle special displays     
         return operatorPatterns[digit - 0xA];  // Operator display
     } else if (digit >= 0 && digit <= 9) {        
-        return digitPatterns[digit]; // Regular digits
+        return seg7_table[digit]; // Regular digits
     } else if (digit == -1) {        
-        return PATTERN_MINUS; // For negative or minus symbol
+        return seg7_table[SEG7_MINUS]; // For negative or minus symbol
     } else {        
-        return PATTERN_BLANK; // Default to blank for invalid digits
+        return seg7_table[SEG7_BLANK]; // Default to blank for invalid digits
     }
 }
 
 
-void displayDigit(int digit, int position, bool dp) { // Display a single digit on one of the 7-segment
+void displayDigit(int digit, int position, bool dp) { // Load a single digit into the frame buffer
     
     unsigned char pattern = encodeDigit(digit);  // Get the segment pattern for this digit        
     if (dp) { // Add decimal point if needed
-        pattern |= SEG_DP;
+        pattern |= SEG7_DP;
     }       
-    LATA = 0x00; // Turn off all displays 
     
-    LATD = pattern;  // Output the segment pattern before selecting the digit to prevent glitches when multiplexing
-    
-    // Then select the digit
-    if (position == 0) { // Tens digit (RA0 = 1, RA1 = 0)       
-        LATA = (1 << TENS_DIGIT_PIN);
-    } else { // Units digit (RA0 = 0, RA1 = 1)        
-        LATA = (1 << UNITS_DIGIT_PIN);
+    if (position == 0) { // Tens digit (RA0)       
+        sevenseg_set(0, pattern);
+    } else { // Units digit (RA1)        
+        sevenseg_set(1, pattern);
     }
 }
 
 
-void refreshDisplay(int number) { // Refresh display to ensure visibility    
-    currentDisplayValue = number;  // Save current display value for future refreshes
+void clearDisplay(void) { // Blank both digits
+    sevenseg_set(0, seg7_table[SEG7_BLANK]);
+    sevenseg_set(1, seg7_table[SEG7_BLANK]);
+}
+
+
+void refreshDisplay(int number) { // Set the value kept on the display by the refresh interrupt    
+    currentDisplayValue = number;  // Save current display value
     isDisplayNegative = (number < 0);
        
-    for (int i = 0; i < 30; i++) { // More refreshes for clearer digit display
-        displayNumber(number);
-    }
+    displayNumber(number);
+}
+
+
+void showOperator(int op) { // Show operator on the left digit until the next display update
+    displayDigit(op, 0, false);    // Left digit shows operator
+    displayDigit(11, 1, false);    // Right digit is blank
+}
+
+
+void showError(void) { // Show "E0" for a divide by zero
+    sevenseg_set(0, seg7_table[SEG7_ERROR]); // Display "E" for error
+    sevenseg_set(1, seg7_table[0]);          // "0" pattern
 }
 
 
-void displayNumber(int number) { // Display a number on the 7-segment display using multiplexing
-    int tens, units;
+void displayNumber(int number) { // Load a number into the frame buffer
+    unsigned char tens, units;
     bool isNegative = false;
         
     if (number < 0) { // Check if negative
@@ -211,360 +316,167 @@ void displayNumber(int number) { // Display a number on the 7-segment display us
     }
     
     // Set digits to correct order
-    tens = number / 10;
-    units = number % 10;
+    tens = bcd_div10_u8((unsigned char)number);  // Multiply by reciprocal, no software division
+    units = (unsigned char)number - tens * 10;
        
     displayDigit(tens, 0, false);  // Display tens digit (no decimal point)
-    __delay_ms(5);
-        
     displayDigit(units, 1, isNegative);  // Display units digit with decimal point if negative
-    __delay_ms(5);
 }
 
 
 void blinkDisplay(int count, int delay_ms) { // Blink all segments of the 7-segment display
     for (int i = 0; i < count; i++) {
         // Turn all segments on for both digits
-        LATA = (1 << TENS_DIGIT_PIN);
-        LATD = 0xFF; // All segments on
-        __delay_ms(10);
-        LATA = (1 << UNITS_DIGIT_PIN);
-        LATD = 0xFF; // All segments on
-        __delay_ms(10);
+        sevenseg_set(0, 0xFF);
+        sevenseg_set(1, 0xFF);
+        timebase_delay_ms(20);
         
         // Turn all segments off for both digits
-        LATA = 0x00;
-        LATD = 0x00; // All segments off
-        __delay_ms(20);
+        clearDisplay();
+        timebase_delay_ms(20);
     }
 }
 
 
 void updateDisplay(int value, int mode) { // Update display based on current mode and value
-    
-    static int previousMode = DISPLAY_RESET;  // Save the previous mode to properly transition 
-       
     displayMode = mode;  // Update display mode
     
-    // Special handling for transition from NUM1 to OPERATOR
-    if (previousMode == DISPLAY_NUM1 && mode == DISPLAY_OPERATOR) {       
-        int rememberedNum1 = currentDisplayValue;  // Remember the num1 value 
-        
-        // Show the operator briefly
-        for (int i = 0; i < 10; i++) {            
-            displayDigit(value, 0, false); // Left digit shows operator
-            __delay_ms(5);
-            
-            displayDigit(11, 1, false); // Right digit is blank
-            __delay_ms(5);
-                       
-            displayNumber(rememberedNum1); // Alternate with showing num1
-            __delay_ms(5);
-        }               
-        currentDisplayValue = rememberedNum1;  // Restore current display value to num1
-    }
-    else {
-        switch (mode) {
-            case DISPLAY_NUM1:
-            case DISPLAY_NUM2:
-            case DISPLAY_RESULT:
-                refreshDisplay(value);
-                break;               
-            case DISPLAY_OPERATOR:  // Display operator (A=+, B=-, C=*, D=/)               
-                for (int i = 0; i < 10; i++) {                    
-                    displayDigit(value, 0, false); // Left digit shows operator
-                    __delay_ms(5);                    
-                    displayDigit(11, 1, false); // Right digit is blank
-                    __delay_ms(5);
-                }
-                break;                
-            case DISPLAY_RESET:
-            default:               
-                refreshDisplay(0); // Show "00" as default/reset display
-                break;
-        }
+    switch (mode) {
+        case DISPLAY_NUM1:
+        case DISPLAY_NUM2:
+        case DISPLAY_RESULT:
+            refreshDisplay(value);
+            break;               
+        case DISPLAY_OPERATOR:  // Display operator (A=+, B=-, C=*, D=/)               
+            showOperator(value);
+            break;                
+        case DISPLAY_RESET:
+        default:               
+            refreshDisplay(0); // Show "00" as default/reset display
+            break;
     }
-        
-    previousMode = mode; // Remember the current mode for next iteration
 }
 
 
-unsigned char scanKeypad() { // keypad scanning function
-    unsigned char col, row;
-    unsigned char key = 0xFF;  // Default to no key pressed (0xFF)
+void postKey(unsigned char code) { // Called by keypad_ISR(), posts the key as a calculator event
+    unsigned char key = keypad_map[code];  // Key value for the physical layout
+    unsigned char type;
     
-    // Always display the current value to maintain visibility
-    if (displayMode == DISPLAY_NUM1 || displayMode == DISPLAY_NUM2 || 
-        displayMode == DISPLAY_RESULT || displayMode == DISPLAY_RESET) {        
-        displayNumber(currentDisplayValue); // Use currentDisplayValue for consistent display
-    } else if (displayMode == DISPLAY_OPERATOR) { // For operator mode, alternate between showing operator and num1        
-        static int displayToggle = 0;       
-        if (displayToggle++ % 3 != 0) {           
-            displayDigit(operator, 0, false); // Display the operator
-            __delay_ms(2);
-            displayDigit(11, 1, false); // Blank
-            __delay_ms(2);
-        } else {            
-            displayNumber(currentDisplayValue); // Periodically show num1  to prevent it from disappearing
-            __delay_ms(2);
-        }
+    if (key <= 9) {
+        type = EVENT_DIGIT;
+    } else if (key <= 0xD) {
+        type = EVENT_OPERATOR;
+    } else if (key == 0xE) {
+        type = EVENT_CLEAR;
+    } else {
+        type = EVENT_EQUALS;
     }
-       
-    LATB &= 0xF0;   // Set all columns low 
-        
-    for (col = 0; col < 4; col++) { // Scan each column       
-        LATB |= (1 << col); // Set current column high              
-        __delay_ms(1); // Wait for signal to stabilize
-               
-        for (row = 0; row < 4; row++) { // Read each row for this column
-            if (PORTB & (1 << (row + 4))) {
-                // Key pressed: calculate the correct key value based on the physical layout                               
-                if (row == 0) {
-                    switch (col) {
-                        case 0: key = 1; break;    // 1
-                        case 1: key = 2; break;    // 2
-                        case 2: key = 3; break;    // 3
-                        case 3: key = 0xA; break;  // A
-                    }
-                }
-                else if (row == 1) {
-                    switch (col) {
-                        case 0: key = 4; break;    // 4
-                        case 1: key = 5; break;    // 5
-                        case 2: key = 6; break;    // 6
-                        case 3: key = 0xB; break;  // B
-                    }
-                }
-                else if (row == 2) {
-                    switch (col) {
-                        case 0: key = 7; break;    // 7
-                        case 1: key = 8; break;    // 8
-                        case 2: key = 9; break;    // 9
-                        case 3: key = 0xC; break;  // C
-                    }
-                }
-                else if (row == 3) {
-                    switch (col) {
-                        case 0: key = 0xE; break;  // * (0xE)
-                        case 1: key = 0; break;    // 0
-                        case 2: key = 0xF; break;  // # (0xF)
-                        case 3: key = 0xD; break;  // D
-                    }
-                }
-                               
-                __delay_ms(10);  // Debounce
-                
-                // Wait for key release with timeout
-                unsigned char timeout = 100;
-                while ((PORTB & (1 << (row + 4))) && (timeout > 0)) {
-                    // Display refresh while waiting for key release
-                    if (displayMode == DISPLAY_NUM1 || displayMode == DISPLAY_NUM2 || 
-                        displayMode == DISPLAY_RESULT || displayMode == DISPLAY_RESET) {
-                        displayNumber(currentDisplayValue);
-                    } else if (displayMode == DISPLAY_OPERATOR) {
-						// Alternate between showing operator and num1
-                        static int innerDisplayToggle = 0;                          
-                        if (innerDisplayToggle++ % 3 != 0) {                            
-                            displayDigit(operator, 0, false); // Display the operator
-                            __delay_ms(2);
-                            displayDigit(11, 1, false); // Blank
-                            __delay_ms(2);
-                        } else {                             
-                            displayNumber(currentDisplayValue); // Periodically show num1
-                            __delay_ms(2);
-                        }
-                    }                    
-                    __delay_ms(1);
-                    timeout--;
-                }
-                               
-                __delay_ms(20); // Final debounce delay
-                               
-                LATB &= ~(1 << col); // Set column back to low
-                                
-                return key; // Return the key value
-            }
-        }
-                
-        LATB &= ~(1 << col); // Set column back to low before trying next column
-    }    
-    return 0xFF;  // No key pressed
+    fsm_post(type, key);
 }
 
 
-int getNum1() { // Get first number from user input
-    num1_tens = 0;
-    num1_units = 0;
-    validInput = false;
-    int currentDisplay = 0;
-    
-    updateDisplay(currentDisplay, DISPLAY_NUM1); // Update display for first number input
-    
-    while (1) {
-        keyVal = scanKeypad();        
-        if (keyVal == 0xFF) { // Continue scanning if no key pressed
-            continue;
-        }
-        
-        if (keyVal == 0xE) { // Check for reset (* key)
-            resetCalculator();
-            return 0xFF; // Return special value to indicate reset
-        }
-        
-        if (keyVal <= 9) { // Get first digit (0-9)
-            num1_tens = keyVal;
-            currentDisplay = num1_tens;
-            validInput = true; // Valid input
-            updateDisplay(currentDisplay, DISPLAY_NUM1);
-            
-            // Wait for second digit or operator
-            while (1) {
-                keyVal = scanKeypad();                              
-                if (keyVal == 0xFF) { // Continue if no key pressed
-                    continue;
-                }                
-                if (keyVal <= 9) { // Check if second digit (0-9)
-                    num1_units = keyVal;
-                    num1 = (num1_tens * 10) + num1_units;
-                    
-                    if (num1 > MAX_INPUT) { // Limit to valid range
-                        num1 = MAX_INPUT;
-                    }
-                   // Update the display with the two-digit number
-                    currentDisplay = num1; 
-                    updateDisplay(num1, DISPLAY_NUM1);
-                    return num1;
-                }                
-                else if (keyVal >= 0xA && keyVal <= 0xD) { // Check if operator (A-D)                   
-                    num1 = num1_tens; // Single digit input followed by operator
-                    currentDisplay = num1; // Update currentDisplay
-                    operator = keyVal;
-                    return num1;
-                }
-                // Check for hash key (#) - allows single-digit input
-                else if (keyVal == 0xF) {
-                    num1 = num1_tens;
-                    currentDisplay = num1; // FIXED: Update currentDisplay
-                    return num1;
-                }
-                // Check for reset (* key)
-                else if (keyVal == 0xE) {
-                    resetCalculator();
-                    return 0xFF; // Return special value for reset
-                }
-            }
-        }
+unsigned char firstDigit1(const FsmEvent *event) {
+    num1_tens = event->data;
+    updateDisplay(num1_tens, DISPLAY_NUM1);
+    return FSM_NEXT;
+}
+
+
+unsigned char secondDigit1(const FsmEvent *event) {
+    num1 = (num1_tens * 10) + event->data;
+    if (num1 > MAX_INPUT) { // Limit to valid range
+        num1 = MAX_INPUT;
     }
+    updateDisplay(num1, DISPLAY_NUM1);  // Two-digit number stays until the operator
+    return FSM_NEXT;
 }
 
 
-int getOperator() { // Get operator input (A, B, C, or D)
-    
-    int storedNum1 = num1; // Store num1 
-        
-    if (operator >= 0xA && operator <= 0xD) { // If operator was already set by getNum1
-        int temp = operator;
-                
-        for (int i = 0; i < 10; i++) { // Display the operator without losing the num1 value
-            
-            displayDigit(temp, 0, false); // Show operator on left digit
-            __delay_ms(5);           
-            displayDigit(11, 1, false); // Show blank on right digit
-            __delay_ms(5);                        
-            displayNumber(storedNum1); // Alternate with showing num1 to maintain its visibility
-            __delay_ms(5);
-        }               
-        currentDisplayValue = storedNum1; // Keep displaying num1
-        
-        return temp;
+unsigned char singleDigit1(const FsmEvent *event) { // '#' after one digit, num1 is single digit input
+    (void)event;
+    num1 = num1_tens;
+    return FSM_NEXT;
+}
+
+
+unsigned char onOperator(const FsmEvent *event) {
+    if (calc.state == CALC_NUM1_MORE) { // Operator right after the first digit
+        num1 = num1_tens;
     }
-    
-    // Wait for operator key while maintaining the num1 display
-    while (1) {       
-        displayNumber(storedNum1); // Keep display num1 
-        __delay_ms(5);        
-        keyVal = scanKeypad();
-                
-        if (keyVal == 0xFF) { // Continue scanning if no key pressed           
-            displayNumber(storedNum1); // Keep displaying num1
-            continue;
-        }               
-        if (keyVal >= 0xA && keyVal <= 0xD) { // Check if valid operator (A-D)
-            // Display the operator briefly
-            for (int i = 0; i < 10; i++) {                
-                displayDigit(keyVal, 0, false); // Show operator on left digit
-                __delay_ms(5);               
-                displayDigit(11, 1, false); // Show blank on right digit
-                __delay_ms(5);                              
-                displayNumber(storedNum1); // Alternate with showing num1 to maintain its visibility
-                __delay_ms(5);
-            }
-                        
-            currentDisplayValue = storedNum1; // Keep displaying num1
-            
-            return keyVal;
-        }        
-        else if (keyVal == 0xE) { // Check for reset (* key)
-            resetCalculator();
-            return 0; // Return 0 to indicate reset
-        }
+    operator = event->data;
+    updateDisplay(operator, DISPLAY_OPERATOR);  // Operator briefly, showNum2() follows
+    fsm_timer_start(OPERATOR_SHOW_MS, EVENT_TIMER);
+    return FSM_NEXT;
+}
+
+
+unsigned char showNum2(const FsmEvent *event) {
+    (void)event;
+    updateDisplay(0, DISPLAY_NUM2);  // "00" waiting for the second number
+    return FSM_NEXT;
+}
+
+
+unsigned char firstDigit2(const FsmEvent *event) {
+    num2_tens = event->data;
+    updateDisplay(num2_tens, DISPLAY_NUM2);
+    return FSM_NEXT;
+}
+
+
+unsigned char secondDigit2(const FsmEvent *event) {
+    num2 = (num2_tens * 10) + event->data;
+    if (num2 > MAX_INPUT) { // Limit to valid range
+        num2 = MAX_INPUT;
     }
+    updateDisplay(num2, DISPLAY_NUM2);
+    return FSM_NEXT;
 }
 
 
-int getNum2() { // Get second number from user input
-    num2_tens = 0;
-    num2_units = 0;
-    validInput = false;
-    int currentDisplay = 0;
-    
-    updateDisplay(currentDisplay, DISPLAY_NUM2); // Update display for second number input
+unsigned char singleDigit2(const FsmEvent *event) { // '#' after one digit, num2 is single digit input
+    (void)event;
+    num2 = num2_tens;
+    return FSM_NEXT;
+}
+
+
+unsigned char onEquals(const FsmEvent *event) {
+    (void)event;
+    result = doOperation(num1, num2, operator); // Calculate result
     
-    while (1) {
-        keyVal = scanKeypad();        
-        if (keyVal == 0xFF) { // Continue scanning if no key pressed
-            continue;
-        }        
-        if (keyVal == 0xE) { // Check for reset (* key)
-            resetCalculator();
-            return 0; // Return 0 to indicate reset
-        }       
-        if (keyVal <= 9) { // Get first digit (0-9)
-            num2_tens = keyVal;
-            currentDisplay = num2_tens;
-            validInput = true; // Mark as valid input
-            updateDisplay(currentDisplay, DISPLAY_NUM2);
-            
-            // Wait for second digit or hash key
-            while (1) {
-                keyVal = scanKeypad();                               
-                if (keyVal == 0xFF) { // Continue if no key pressed
-                    continue;
-                }                
-                if (keyVal <= 9) { // Check if second digit (0-9)
-                    num2_units = keyVal;
-                    num2 = (num2_tens * 10) + num2_units;
-                    
-                    if (num2 > MAX_INPUT) { // Limit to valid range
-                        num2 = MAX_INPUT;
-                    }
-                    updateDisplay(num2, DISPLAY_NUM2);
-                    waitingForHashKey = true;
-                    return num2;
-                }
-                
-                else if (keyVal == 0xF) { // Check if hash key (#) - num2 is 1-digit number
-                    num2 = num2_tens;
-                    waitingForHashKey = true;
-                    return num2;
-                }               
-                else if (keyVal == 0xE) { // Check for reset (* key)
-                    resetCalculator();
-                    return 0; // Return 0 to indicate reset
-                }
-            }
-        }
+    if (operator == 0xD && num2 == 0) { // Division by zero - blink "E0", then show the result
+        errorPhases = 2 * ERROR_BLINKS - 1;
+        showError();
+        fsm_timer_start(ERROR_ON_MS, EVENT_TIMER);
+        return CALC_ERROR;
     }
+    updateDisplay(result, DISPLAY_RESULT); // Display the result
+    return FSM_NEXT;
+}
+
+
+unsigned char errorBlink(const FsmEvent *event) {
+    (void)event;
+    if (errorPhases == 0) {
+        updateDisplay(result, DISPLAY_RESULT);
+        return CALC_RESULT;
+    }
+    if (errorPhases-- & 1) {
+        clearDisplay(); // Turn off display briefly
+        fsm_timer_start(ERROR_OFF_MS, EVENT_TIMER);
+    } else {
+        showError();
+        fsm_timer_start(ERROR_ON_MS, EVENT_TIMER);
+    }
+    return FSM_NEXT;
+}
+
+
+unsigned char onClear(const FsmEvent *event) {
+    (void)event;
+    resetCalculator();
+    return FSM_NEXT;
 }
 
 
@@ -592,22 +504,7 @@ int doOperation(int num1, int num2, int operator) { // Perform the calculation b
             if (num2 != 0) {
                 result = num1 / num2;
             } else {
-                // Division by zero - display error
-                for (int i = 0; i < 5; i++) {                    
-                    LATA = (1 << TENS_DIGIT_PIN);
-                    LATD = PATTERN_E;  // Display "E" for error
-                    __delay_ms(100);
-                    
-                    LATA = (1 << UNITS_DIGIT_PIN);
-                    LATD = digitPatterns[0];  // "0" pattern
-                    __delay_ms(100);
-                    
-                    // Turn off display briefly
-                    LATA = 0x00;
-                    LATD = 0x00;
-                    __delay_ms(100);
-                }
-                return 0; // Return 0 after division by zero error
+                return 0; // Return 0 after division by zero error, onEquals() shows it
             }
             break;
         default:
@@ -625,55 +522,12 @@ int doOperation(int num1, int num2, int operator) { // Perform the calculation b
 }
 
 
-void displayResult() { // Display the calculation result
-    // Indicate waiting for # key if needed
-    if (!waitingForHashKey) {
-        // Blink display to to show waiting for '#' key
-        for (int i = 0; i < 3; i++) {
-            LATA = 0x00;  // Turn off digit select
-            LATD = 0x00;  // Turn off all segments
-            __delay_ms(200);
-                        
-            refreshDisplay(num2); // Show current inputs, num2
-            __delay_ms(200);
-        }
-    }
-
-    // Wait for # key to complete calculation
-    while (1) {
-        keyVal = scanKeypad();
-                
-        if (keyVal == 0xFF) { // Continue if no key pressed
-            continue;
-        }
-        if (keyVal == 0xF) { // '#' key pressed           
-            result = doOperation(num1, num2, operator); // Calculate result                      
-            updateDisplay(result, DISPLAY_RESULT); // Display the result
-            
-            // Enter result display loop
-            while(1) {
-                keyVal = scanKeypad();
-                if (keyVal == 0xE) {
-                    resetCalculator();
-                    return;
-                }
-            }
-        }
-        else if (keyVal == 0xE) { // '*' key for reset
-            resetCalculator();
-            return;
-        }
-    }
-}
-
-
 void resetCalculator() { // Reset the calculator state
     // Reset all variables
     num1 = 0;
     num2 = 0;
     operator = 0;
-    waitingForHashKey = false;
-    validInput = false;
+    fsm_timer_stop();
     displayMode = DISPLAY_RESET;
     currentDisplayValue = 0;
     isDisplayNegative = false;
@@ -685,28 +539,13 @@ void resetCalculator() { // Reset the calculator state
 void main(void) {
     
     initialize(); // Initialize hardware
+    resetCalculator(); // Reset calculator state, calc starts in CALC_NUM1
     
-    // Main program loop
-    while (1) {        
-        resetCalculator(); // Reset calculator state
-                
-        num1 = getNum1(); // Get first number
-        if (num1 == 0xFF) continue; // Reset occurred
-                
-        currentDisplayValue = num1; // Keep displaying num1
-               
-        operator = getOperator(); // Get operator
-        if (operator == 0) continue; // Reset occurred
-                
-        int savedNum1 = currentDisplayValue; // Check if num1 is still maintained
-                
-        num2 = getNum2(); // Get second number
-        if (num2 == 0xFF) continue; // Reset occurred
-               
-        num1 = savedNum1; // Restore num1 to correct value for calculation
-                
-        displayResult(); // Display result
-                
-        __delay_ms(500); // Short delay before next calculation
+    // Main program loop, every key and timer event goes through calcTable[]
+    while (1) {
+        PROF_ENTER(PROF_FSM);
+        fsm_run(&calc);
+        PROF_EXIT(PROF_FSM);
+        POWER_IDLE_UNLESS(fsm_pending());  // Nothing to do until the next tick or key press
     }
 }
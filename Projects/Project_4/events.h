@@ -0,0 +1,37 @@
+/*
+ * File: events.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Events of the lock box state machine. The ISRs only post an event with fsm_post()
+ *          (Common/fsm.h): INT0 the emergency button, the ADC threshold ISR a PR cover, the tick
+ *          the debounced confirm button. The main loop dispatches them through the transition
+ *          table in main.c, and the unlock task posts EVENT_RELOCKED when the box is locked again.
+ */
+
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include <xc.h>
+#include <stdbool.h>
+#include "../Common/fsm.h"
+
+//=============================================================================
+// EVENT DEFINITIONS
+//=============================================================================
+typedef enum {
+    EVENT_NONE,
+    EVENT_EMERGENCY,       // Emergency button pressed (INT0)
+    EVENT_PR1_COVER,       // PR1 covered (ADC threshold)
+    EVENT_PR2_COVER,       // PR2 covered (ADC threshold)
+    EVENT_BUTTON,          // Confirm button pressed (debounced falling edge)
+    EVENT_RELOCKED         // Unlock sequence finished, the box is locked again
+} EventType;
+
+//=============================================================================
+// GLOBAL VARIABLES
+//=============================================================================
+extern Fsm lock_fsm;  // Lock box state machine, state is a SystemState, defined in main.c
+
+#endif /* EVENTS_H */
@@ -0,0 +1,391 @@
+/*
+ * File: functions.c
+ * Author: Huy Nguyen
+ *
+ * Created on April 17, 2025
+ *
+ * Purpose: Actions of the lock box state machine, the tasks and the INT0 ISR (functions.h).
+ */
+
+#include <xc.h>
+#include "functions.h"
+#include "../Common/debounce.h"
+#include "../Common/buzzer.h"
+#include "../Common/power.h"
+#include "../Common/sevenseg.h"
+
+//=============================================================================
+// GLOBAL VARIABLES DEFINITION
+//=============================================================================
+unsigned char current_digit = 0;  // Digit being entered
+unsigned char code_position = 0;  // Digits entered so far
+unsigned int entered_code = 0;    // Entered digits, one per nibble
+
+//=============================================================================
+// TASK AND DISPLAY STATE
+//=============================================================================
+static UnlockPhase unlock_phase = UNLOCK_IDLE;        // Step of the unlock task
+static EmergencyPhase emergency_phase = EMERGENCY_IDLE;  // Step of the emergency task
+static const unsigned char digit_select[1] = {1 << DIGIT_ONES_PIN};  // RA1 selects the ones digit
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Initialize the system
+void initialize_system(void) {
+    clock_init();  // Clock profile first, the timers below depend on it
+    POWER_MODULES_OFF();  // Unused modules off before anything is set up
+    PROF_INIT();  // Trace pin and Timer1 cycle stamps in profiling builds
+    
+    // Disable all analog functionality
+    ANSELA = 0; ANSELB = 0;  ANSELC = 0; ANSELD = 0;
+        
+    // Set up inputs/outputs
+    TRISAbits.TRISA2 = 0;  // RA2 output (motor)
+    TRISAbits.TRISA5 = 0;  // RA5 output (buzzer)
+    
+    TRISCbits.TRISC2 = 0;  // RC2 output (LED D1)
+    TRISCbits.TRISC3 = 0;  // RC3 output (LED D2)
+    TRISCbits.TRISC7 = 1;  // RC7 input (confirm button)
+    
+    TRISBbits.TRISB0 = 1;  // RB0 input (interrupt button)
+    
+    // Enable weak pull-ups for inputs
+    WPUA = 0;              // No pull-ups on PORTA
+    WPUB = (1 << 0);       // Pull-up on RB0 (iterrupt button)
+    WPUC = (1 << 7);       // Pull-up on RC7 (confirm button)
+    
+    // Initialize outputs
+    LED_D1_OFF();         // D1 will blink
+    LED_D2_ON();          // D2 on solid
+    MOTOR_OFF();          // Motor off
+    sevenseg_init(digit_select, 1);  // PORTD segments, ones digit always selected
+    LATAbits.LATA5 = 0;   // Buzzer pin low while the PWM is off
+    RA5PPS = BUZZER_PPS_CCP1;  // Route CCP1 to the buzzer on RA5
+    buzzer_init();        // Buzzer PWM on, silent
+    
+    debounce_init();      // Debounced levels start at the current inputs
+    
+    // Start the 1 ms scheduler tick
+    scheduler_init();
+    
+    // PR1/PR2 on the ADC, converted on every tick
+    photo_init();
+    
+    // Config and event counts from the Data EEPROM, before interrupts are on
+    storage_init();
+    lockout_init(storage_streak);  // A lockout running at the reset starts again
+    
+    // Initialize interrupts for the emergency button on RB0/INT0
+    // Disable interrupts while configuring
+    INTCON0bits.GIEH = 0;     // Disable high priority interrupts
+    INTCON0bits.GIEL = 0;     // Disable low priority interrupts
+
+    INTCON0bits.IPEN = 1;     // Enable interrupt priority
+    
+    // Configure INT0 for active-low button (falls when pressed)
+    INTCON0bits.INT0EDG = 0;  // Interrupt on falling edge (button press)
+    IPR1bits.INT0IP = 1;      // High priority for INT0
+    PIE1bits.INT0IE = 1;      // Enable INT0 interrupt
+    PIR1bits.INT0IF = 0;      // Clear interrupt flag
+    
+    // Change IVTBASE
+    IVTBASEU = 0x00;
+    IVTBASEH = 0x40;
+    IVTBASEL = 0x08;
+    
+    // Enable interrupts
+    INTCON0bits.GIEH = 1;     // Enable high priority interrupts
+    INTCON0bits.GIEL = 1;     // Enable low priority interrupts
+    
+    // Initialize display
+    current_digit = 0;
+    display_digit(0);         // Explicitly display digit 0
+    
+    // Initial state
+    lock_fsm.state = STATE_READY;
+    code_position = 0;
+    entered_code = 0;
+    
+    // Reset task state
+    unlock_phase = UNLOCK_IDLE;
+    emergency_phase = EMERGENCY_IDLE;
+}
+
+// Display a digit on the 7-segment display
+void display_digit(unsigned char digit) {
+    sevenseg_set(0, seg7_table[digit & 0x0F]);  // Set the segment pattern, the digit stays selected
+}
+
+// Beep sounds, each followed by a short silence
+static const Note beep_short[]  = {{BUZZER_PERIOD(2000), BUZZER_LEN(50)},   {NOTE_REST, BUZZER_LEN(BEEP_GAP_MS)}, NOTE_END};
+static const Note beep_medium[] = {{BUZZER_PERIOD(2000), BUZZER_LEN(300)},  {NOTE_REST, BUZZER_LEN(BEEP_GAP_MS)}, NOTE_END};
+static const Note beep_long[]   = {{BUZZER_PERIOD(2000), BUZZER_LEN(500)},  {NOTE_REST, BUZZER_LEN(BEEP_GAP_MS)}, NOTE_END};
+static const Note beep_fail[]   = {{BUZZER_PERIOD(500),  BUZZER_LEN(2000)}, {NOTE_REST, BUZZER_LEN(BEEP_GAP_MS)}, NOTE_END};
+static const Note beep_locked[] = {{BUZZER_PERIOD(500),  BUZZER_LEN(100)},  {NOTE_REST, BUZZER_LEN(100)},
+                                   {BUZZER_PERIOD(500),  BUZZER_LEN(100)},  {NOTE_REST, BUZZER_LEN(BEEP_GAP_MS)}, NOTE_END};
+
+// Distinctive emergency melody: three high/low tone pairs
+static const Note emergency_melody[] = {
+    {BUZZER_PERIOD(2500), BUZZER_LEN(200)}, {NOTE_REST, BUZZER_LEN(100)},  // High tone
+    {BUZZER_PERIOD(1000), BUZZER_LEN(400)}, {NOTE_REST, BUZZER_LEN(200)},  // Low tone
+    {BUZZER_PERIOD(2500), BUZZER_LEN(200)}, {NOTE_REST, BUZZER_LEN(100)},
+    {BUZZER_PERIOD(1000), BUZZER_LEN(400)}, {NOTE_REST, BUZZER_LEN(200)},
+    {BUZZER_PERIOD(2500), BUZZER_LEN(200)}, {NOTE_REST, BUZZER_LEN(100)},
+    {BUZZER_PERIOD(1000), BUZZER_LEN(400)}, {NOTE_REST, BUZZER_LEN(200)},
+    NOTE_END
+};
+
+// Queue a beep with fixed durations. Returns immediately, the tick interrupt plays it.
+void beep(unsigned char beep_type) {
+    PROF_ENTER(PROF_BEEP);
+    switch(beep_type) {
+        case BEEP_MEDIUM: buzzer_play(beep_medium); break;  // Medium beep
+        case BEEP_LONG:   buzzer_play(beep_long);   break;  // Long beep
+        case BEEP_FAIL:   buzzer_play(beep_fail);   break;  // Incorrect code
+        case BEEP_LOCKED: buzzer_play(beep_locked); break;  // Entry locked out
+        case BEEP_SHORT:
+        default:          buzzer_play(beep_short);  break;  // Short beep
+    }
+    PROF_EXIT(PROF_BEEP);
+}
+
+// Start the emergency melody on the buzzer. Pending beeps are dropped.
+void play_emergency_melody(void) {
+    buzzer_play_now(emergency_melody);
+}
+
+// Start the emergency melody and LED sequence
+void start_emergency(void) {
+    task_cancel(TASK_BLINK);  // D1 is used for the emergency flash
+    LED_D1_OFF();
+    
+    play_emergency_melody();
+    
+    emergency_phase = EMERGENCY_MELODY;
+    task_schedule(TASK_EMERGENCY, 0);
+}
+
+// Emergency task: wait for the melody, flash D1 for 500 ms, then resume blinking
+void emergency_task(void) {
+    switch (emergency_phase) {
+        case EMERGENCY_MELODY:
+            if (buzzer_busy()) {  // Let the melody finish first
+                task_schedule(TASK_EMERGENCY, 10);
+                break;
+            }
+            LED_D1_ON();  // Visual feedback
+            emergency_phase = EMERGENCY_FLASH;
+            task_schedule(TASK_EMERGENCY, EMERGENCY_FLASH_MS);
+            break;
+            
+        case EMERGENCY_FLASH:
+            LED_D1_OFF();
+            emergency_phase = EMERGENCY_IDLE;
+            if (lock_fsm.state != STATE_UNLOCKED) {
+                task_schedule(TASK_BLINK, BLINK_HALF_PERIOD_MS);
+            }
+            break;
+            
+        default:
+            break;
+    }
+}
+
+// Play incorrect code buzzer
+void play_incorrect_code(void) {
+    beep(BEEP_FAIL);  // 2 seconds of buzzer
+}
+
+// Handle system unlocking. Starts the unlock sequence and returns, unlock_task() runs the motor.
+void handle_unlock(void) {
+    // Turn D1 solid, D2 off
+    task_cancel(TASK_BLINK);
+    LED_D1_ON();
+    LED_D2_OFF();
+       
+    beep(3);  // Success beep (long)
+    
+    unlock_phase = UNLOCK_BEEP;
+    task_schedule(TASK_UNLOCK, 0);
+}
+
+// Unlock task: wait for the success beep, then run the motor for 5 seconds
+void unlock_task(void) {
+    switch (unlock_phase) {
+        case UNLOCK_BEEP:
+            if (buzzer_busy()) {  // Let the success beep finish first
+                task_schedule(TASK_UNLOCK, 10);
+                break;
+            }
+            MOTOR_ON();
+            unlock_phase = UNLOCK_MOTOR;
+            task_schedule(TASK_UNLOCK, MOTOR_RUN_MS);
+            break;
+            
+        case UNLOCK_MOTOR:
+            MOTOR_OFF();
+            finish_unlock();
+            break;
+            
+        default:
+            break;
+    }
+}
+
+// Stop the motor and end the unlock sequence early
+void cancel_unlock(void) {
+    if (unlock_phase != UNLOCK_IDLE) {
+        MOTOR_OFF();
+        task_cancel(TASK_UNLOCK);
+        finish_unlock();
+    }
+}
+
+// Relock the box after the unlock sequence, the state machine returns to STATE_READY
+void finish_unlock(void) {
+    unlock_phase = UNLOCK_IDLE;
+    
+    // Return to ready state
+    LED_D1_OFF();  // D1 blinks again
+    LED_D2_ON();   // D2 back on
+    task_schedule(TASK_BLINK, BLINK_HALF_PERIOD_MS);
+    
+    fsm_post(EVENT_RELOCKED, 0);
+    current_digit = 0;
+    display_digit(0);
+}
+
+// Blink LED D1 (task, toggles every 500 ms)
+void blink_d1(void) {
+    LED_D1_TOGGLE();
+    task_schedule(TASK_BLINK, BLINK_HALF_PERIOD_MS);
+}
+
+// Briefly turn LED D2 off for feedback
+void flash_d2(void) {
+    LED_D2_OFF();
+    task_schedule(TASK_FLASH, D2_FLASH_MS);
+}
+
+// Flash task: turns LED D2 back on
+void flash_task(void) {
+    LED_D2_ON();
+}
+
+// Emergency button from any state: log it, stop the motor and clear the entry, then start the
+// melody and D1 flash. Presses stamped while the previous sequence plays are bounces or repeats.
+unsigned char handle_emergency(const FsmEvent *event) {
+    // Stamp of the last accepted emergency press
+    static unsigned int emergency_time = 0;
+    static bool emergency_seen = false;
+    
+    if (emergency_seen && (unsigned int)(event->stamp - emergency_time) < EMERGENCY_HOLDOFF_MS) {
+        return FSM_SAME;
+    }
+    emergency_seen = true;
+    emergency_time = event->stamp;
+    
+    storage_log(LOG_EMERGENCY);
+    cancel_unlock();  // Stop the motor if the box was opening
+    current_digit = 0;
+    code_position = 0;
+    entered_code = 0;
+    display_digit(0);
+    
+    start_emergency();  // Melody and LED flash run as tasks
+    return FSM_NEXT;
+}
+
+// Button in STATE_READY: start a code entry, unless entry is locked out
+unsigned char start_code_entry(const FsmEvent *event) {
+    (void)event;
+    if (lockout_active()) {
+        beep(BEEP_LOCKED);  // No new code entry while locked out
+        return FSM_SAME;
+    }
+    
+    beep(2);  // Audio feedback with medium beep
+    code_position = 0;
+    entered_code = 0;
+    current_digit = 0;
+    display_digit(0);
+    photo_select(PHOTO_PR1);  // First digit comes from PR1
+    return FSM_NEXT;
+}
+
+// Button in STATE_CODE_INPUT: take the digit, check the code after the last one
+unsigned char process_button_press(const FsmEvent *event) {
+    (void)event;
+    beep(2);  // Audio feedback
+    
+    // Add the digit to the entered code (first digit in the highest nibble)
+    entered_code = (entered_code << 4) | current_digit;
+    current_digit = 0;
+    display_digit(0);
+    
+    if (++code_position < storage_config.code_length) { // Next digit
+        photo_select((code_position & 1) ? PHOTO_PR2 : PHOTO_PR1);  // PR1 and PR2 take turns
+        return FSM_SAME;
+    }
+    
+    if (code_submit(entered_code) == CODE_ACCEPTED) { // Check if code matches
+        handle_unlock(); // Correct code entered - unlock, EVENT_RELOCKED returns to ready when done
+        return STATE_UNLOCKED;
+    }
+    
+    LED_D2_ON(); // Incorrect code entered - keep D2 on, box stays locked
+    play_incorrect_code(); // Failure beep
+    return FSM_NEXT;
+}
+
+// PR1 cover in STATE_CODE_INPUT: count the even code digits
+unsigned char process_pr1(const FsmEvent *event) {
+    (void)event;
+    if (!(code_position & 1)) {
+        // Increment the digit (with rollover)
+        if (current_digit < CODE_DIGIT_MAX) {
+            current_digit++;
+        } else {
+            current_digit = 0;
+        }
+        
+        display_digit(current_digit); // Update display
+        
+        beep(1);  // Short beep
+    }
+    return FSM_NEXT;
+}
+
+// PR2 cover in STATE_CODE_INPUT: count the odd code digits
+unsigned char process_pr2(const FsmEvent *event) {
+    (void)event;
+    if (code_position & 1) {
+        // Increment the digit (with rollover)
+        if (current_digit < CODE_DIGIT_MAX) {
+            current_digit++;
+        } else {
+            current_digit = 0;
+        }
+        
+        display_digit(current_digit); // Update display
+        
+        flash_d2();  // Visual feedback - flash D2
+        
+        beep(1);  // Audible feedback - Short beep
+    }
+    return FSM_NEXT;
+}
+
+// Interrupt service routine: only records the emergency, handle_emergency() and emergency_task() handle it
+void __interrupt(irq(IRQ_INT0), base(0x4008)) ISR(void) {
+    PROF_ENTER(PROF_INT0);
+    if (PIR1bits.INT0IF) {
+        
+        fsm_post(EVENT_EMERGENCY, 0);  // Timestamp and queue the emergency
+               
+        PIR1bits.INT0IF = 0;  // Clear interrupt flag
+    }
+    PROF_EXIT(PROF_INT0);
+}
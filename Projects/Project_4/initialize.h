@@ -14,7 +14,10 @@
 #include <stdbool.h>
 
 
-#define LOCKING_CODE 0x21  // Secret code (tens digit = 2, ones digit = 1)
+#define LOCKING_CODE 0x21  // Factory code (first digit = 2, second digit = 1), until one is stored (storage.h)
+#define CODE_LENGTH 2       // Digits in the factory code
+#define CODE_MAX_LENGTH 4   // Longest code, one nibble per digit
+#define CODE_DIGIT_MAX 4    // Digits count 0 to 4 with the PR covers
 
 //=============================================================================
 // HARDWARE DEFINITIONS
@@ -38,53 +41,71 @@
 // Control macros
 #define LED_D1_ON()         LATCbits.LATC2 = 1
 #define LED_D1_OFF()        LATCbits.LATC2 = 0
+#define LED_D1_TOGGLE()     LATCbits.LATC2 ^= 1
 #define LED_D2_ON()         LATCbits.LATC3 = 1
 #define LED_D2_OFF()        LATCbits.LATC3 = 0
-#define BUZZER_ON()         LATAbits.LATA5 = 1
-#define BUZZER_OFF()        LATAbits.LATA5 = 0
 #define MOTOR_ON()          LATAbits.LATA2 = 1
 #define MOTOR_OFF()         LATAbits.LATA2 = 0
 
-// 7-segment display segments
-#define SEG_G               0   // RD0 - Segment G
-#define SEG_F               1   // RD1 - Segment F
-#define SEG_E               2   // RD2 - Segment E
-#define SEG_D               3   // RD3 - Segment D
-#define SEG_C               4   // RD4 - Segment C
-#define SEG_B               5   // RD5 - Segment B
-#define SEG_A               6   // RD6 - Segment A
-#define SEG_DP              7   // RD7 - Decimal Point
-
-// Segment patterns for digits 0-9
-#define PATTERN_0  ((1 << SEG_A) | (1 << SEG_B) | (1 << SEG_C) | (1 << SEG_D) | (1 << SEG_E) | (1 << SEG_F))
-#define PATTERN_1  ((1 << SEG_B) | (1 << SEG_C))
-#define PATTERN_2  ((1 << SEG_A) | (1 << SEG_B) | (1 << SEG_D) | (1 << SEG_E) | (1 << SEG_G))
-#define PATTERN_3  ((1 << SEG_A) | (1 << SEG_B) | (1 << SEG_C) | (1 << SEG_D) | (1 << SEG_G))
-#define PATTERN_4  ((1 << SEG_B) | (1 << SEG_C) | (1 << SEG_F) | (1 << SEG_G))
+// 7-segment patterns come from seg7_table[] in Common/sevenseg.h (a = RD6 ... g = RD0)
+
+//=============================================================================
+// TIMING DEFINITIONS (milliseconds)
+//=============================================================================
+#define BLINK_HALF_PERIOD_MS  500    // LED D1 on/off time while the box is locked
+#define BEEP_GAP_MS           50     // Silence after each beep
+#define MOTOR_RUN_MS          5000   // Motor on time after a correct code
+#define D2_FLASH_MS           50     // LED D2 off time for PR2 feedback
+#define EMERGENCY_FLASH_MS    500    // LED D1 on time after the emergency melody
+#define EMERGENCY_HOLDOFF_MS  3200   // Emergency presses ignored while the sequence plays
+
+// Beep types
+#define BEEP_SHORT          1   // 50 ms
+#define BEEP_MEDIUM         2   // 300 ms
+#define BEEP_LONG           3   // 500 ms
+#define BEEP_FAIL           4   // 2000 ms incorrect code tone
+#define BEEP_LOCKED         5   // Two low 100 ms tones, entry refused during a lockout
+
+//=============================================================================
+// POWER DEFINITIONS (Common/power.h)
+//=============================================================================
+// Modules switched off, only Timer0 (tick), Timer2 + CCP1 (buzzer), NVM and IOC stay on
+#define POWER_PMD0          0x7A    // FVR, HLVD, CRC, SCAN, CLKR off
+#define POWER_PMD1          0xFA    // All timers except TMR0 and TMR2, SMT1 off
+#define POWER_PMD2          0x47    // DAC, CMP1, CMP2, ZCD off (ADC reads the PRs)
+#define POWER_PMD3          0xFE    // CCP2-4, PWM5-8 off
+#define POWER_PMD4          0x17    // CWG1-3, NCO1 off
+#define POWER_PMD5          0x01    // DSM1 off
+#define POWER_PMD6          0x3F    // UARTs, SPIs, I2Cs off
+#define POWER_PMD7          0x3F    // CLCs, DMAs off
 
 //=============================================================================
 // SYSTEM STATE DEFINITIONS
 //=============================================================================
 typedef enum {
     STATE_READY,       // System is ready for code entry
-    STATE_TENS_INPUT,  // Getting tens digit input from PR1
-    STATE_ONES_INPUT,  // Getting ones digit input from PR2
+    STATE_CODE_INPUT,  // Getting code digits, even positions from PR1, odd positions from PR2
     STATE_UNLOCKED,    // System is unlocked (code matched)
     STATE_EMERGENCY    // Emergency interrupt triggered
 } SystemState;
 
+typedef enum {
+    UNLOCK_IDLE,       // No unlock sequence running
+    UNLOCK_BEEP,       // Waiting for the success beep to finish
+    UNLOCK_MOTOR       // Motor running
+} UnlockPhase;
+
+typedef enum {
+    EMERGENCY_IDLE,    // No emergency sequence running
+    EMERGENCY_MELODY,  // Waiting for the emergency melody to finish
+    EMERGENCY_FLASH    // LED D1 on after the melody
+} EmergencyPhase;
+
 //=============================================================================
 // GLOBAL VARIABLES
 //=============================================================================
-extern SystemState system_state;
-extern unsigned char current_digit;   // Currently displayed digit
-extern unsigned char tens_digit;      // Stored tens digit
-extern unsigned char ones_digit;      // Stored ones digit
-extern unsigned char entered_code;    // Final entered code
-extern volatile bool emergency_active;
-
-// Counter for global timing
-extern unsigned int debounce_counter;
-extern unsigned char blink_counter;  // Counter for blinking LED D1
+extern unsigned char current_digit;   // Digit being entered, shown on the display
+extern unsigned char code_position;   // Digits of the code entered so far
+extern unsigned int entered_code;     // Entered digits, one per nibble
 
 #endif /* INIT_H */
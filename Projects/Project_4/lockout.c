@@ -0,0 +1,80 @@
+/*
+ * File: lockout.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Code check and failed attempt lockout (lockout.h).
+ */
+
+#include <xc.h>
+#include "lockout.h"
+
+//=============================================================================
+// LOCKOUT STATE
+//=============================================================================
+static unsigned char lockout_failures = 0;  // Failed attempts in a row since the last unlock
+static unsigned int lockout_left = 0;       // Seconds until code entry is allowed again
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Restore the failure run, after scheduler_init(). A run that had reached a lockout starts its
+// window again, so a reset is no way around it.
+void lockout_init(unsigned char failures) {
+    lockout_failures = failures;
+    lockout_left = lockout_window(failures);
+    if (lockout_left) {
+        task_schedule(TASK_LOCKOUT, LOCKOUT_STEP_MS);
+    }
+}
+
+// Lockout window in seconds after failures in a row: 0 for the free attempts, then
+// LOCKOUT_BASE_S doubling per failure up to LOCKOUT_MAX_S
+unsigned int lockout_window(unsigned char failures) {
+    unsigned int window = LOCKOUT_BASE_S;
+
+    if (failures < LOCKOUT_FREE_ATTEMPTS) {
+        return 0;
+    }
+    for (failures -= LOCKOUT_FREE_ATTEMPTS; failures && window < LOCKOUT_MAX_S; failures--) {
+        window <<= 1;
+    }
+    return (window < LOCKOUT_MAX_S) ? window : LOCKOUT_MAX_S;
+}
+
+// Check if code entry is locked out
+bool lockout_active(void) {
+    return lockout_left != 0;
+}
+
+// Check an entered code against the stored one, log the attempt and start a lockout window
+// when the failure run calls for one. Never blocks.
+CodeResult code_submit(unsigned int code) {
+    if (lockout_active()) {
+        return CODE_LOCKED_OUT;
+    }
+    if (code == storage_config.locking_code) {
+        lockout_failures = 0;
+        storage_log(LOG_UNLOCK);
+        return CODE_ACCEPTED;
+    }
+
+    if (lockout_failures < 0xFF) {
+        lockout_failures++;
+    }
+    storage_log(LOG_FAILED);
+    lockout_left = lockout_window(lockout_failures);
+    if (lockout_left) {
+        task_schedule(TASK_LOCKOUT, LOCKOUT_STEP_MS);
+    }
+    return CODE_REJECTED;
+}
+
+// Lockout task: one step per second until the window has run out
+void lockout_task(void) {
+    if (lockout_left && --lockout_left) {
+        task_schedule(TASK_LOCKOUT, LOCKOUT_STEP_MS);
+    }
+}
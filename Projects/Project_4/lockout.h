@@ -0,0 +1,48 @@
+/*
+ * File: lockout.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Code check with attempt tracking and an exponential backoff lockout.
+ *          The first LOCKOUT_FREE_ATTEMPTS failures in a row cost nothing but the fail tone, so
+ *          a mistyped code can be entered again at once. Every further failure locks code entry
+ *          for LOCKOUT_BASE_S seconds, doubled per failure up to LOCKOUT_MAX_S. An unlock clears
+ *          the count. The window counts down in TASK_LOCKOUT on the 1 ms scheduler, so nothing
+ *          blocks while the box is locked out. The failure run comes back from the event log at
+ *          boot (storage.h), so a reset does not clear it.
+ */
+
+#ifndef LOCKOUT_H
+#define LOCKOUT_H
+
+#include <xc.h>
+#include <stdbool.h>
+#include "initialize.h"
+#include "scheduler.h"
+#include "storage.h"
+
+//=============================================================================
+// LOCKOUT DEFINITIONS
+//=============================================================================
+#define LOCKOUT_FREE_ATTEMPTS   3       // Failures in a row before the first lockout
+#define LOCKOUT_BASE_S          5       // First lockout window in seconds
+#define LOCKOUT_MAX_S           600     // Longest lockout window (10 min)
+#define LOCKOUT_STEP_MS         1000    // TASK_LOCKOUT period
+
+typedef enum {
+    CODE_REJECTED,     // Wrong code, counted
+    CODE_ACCEPTED,     // Code matches, the count is cleared
+    CODE_LOCKED_OUT    // Entry is locked out, the code was not checked
+} CodeResult;
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void lockout_init(unsigned char failures);  // Restore the failure run, after scheduler_init()
+unsigned int lockout_window(unsigned char failures);  // Lockout window in seconds after failures in a row
+bool lockout_active(void);  // Check if code entry is locked out
+CodeResult code_submit(unsigned int code);  // Check an entered code against the stored one
+void lockout_task(void);  // Lockout task: counts the window down
+
+#endif /* LOCKOUT_H */
@@ -15,28 +15,74 @@
  *	    PORTB [3:1] Control keypad's column 1- 3 operation
  * 	    PORTD [7:0] Control 7-Segment display
  * Version: 20+
+ *          10/14/2026 - Main loop replaced by a 1 ms cooperative scheduler. The unlock, buzzer and
+ *                       LED sequences run as tasks so inputs keep being sampled every tick.
+ *                     - Emergency ISR only queues an event, the melody and LED flash run as a task.
+ *                     - Buzzer driven by CCP1 PWM, sounds are note tables played from the tick interrupt.
+ *                     - Digit patterns come from the shared const seg7_table[] (Common/sevenseg.h).
+ *                     - Core idles between scheduler passes and unused modules are off (Common/power.h).
+ *                     - Clock from the Common/clock.h profiles (HFINTOSC), tick and tone timers follow it.
+ *                     - Tick counter moved to the shared millisecond timebase (Common/timebase.h).
+ *                     - Button and PR inputs debounced by the shared integrator (Common/debounce.h),
+ *                       the hold-off timers and previous-state flags are gone.
+ *                     - PR1/PR2 read by the ADC with threshold interrupts and hysteresis (photo.h),
+ *                       the periodic pin reinitialization is gone.
+ *                     - Profiling hooks (Common/prof.h) in the ISRs, input_task(), beep() and the main
+ *                       loop, compiled out unless PROF_ENABLE is defined.
+ *                     - Locking code and counts of failed attempts, emergencies and unlocks kept in the
+ *                       Data EEPROM (storage.h): config block loaded at boot, wear-leveled event log
+ *                       written byte by byte from the NVM interrupt, so nothing waits for a write.
+ *                     - Code check with a lockout after 3 failures in a row, 5 s doubling up to 10 min,
+ *                       counted down by a task (lockout.h). Code length is configurable up to 4 digits,
+ *                       entered alternately with PR1 and PR2.
+ *                     - Input runs on the shared table-driven state machine (Common/fsm.h): the ISRs post
+ *                       emergency, PR cover and button events, lock_transitions[] maps each state and
+ *                       event to one action in functions.h. input_task() and the copies of its button
+ *                       and PR handling in functions.h are gone.
+ *                     - Modules compiled separately: the function bodies moved from the headers into
+ *                       functions.c, scheduler.c, photo.c, storage.c and lockout.c, the configuration
+ *                       bits into config.c. The buzzer driver and the ADC set-up moved to shared
+ *                       Common/buzzer.h and Common/adc.h. The Makefile links only the modules used.
+ *                       Each module defines its own state, main.c keeps the task table, the
+ *                       transitions and main().
  */
 
 #include <xc.h>
 #include <stdbool.h>
 #include "config.h"
 #include "initialize.h"
+#include "scheduler.h"
+#include "events.h"
+#include "photo.h"
+#include "storage.h"
+#include "lockout.h"
 #include "functions.h"
-#include "C:/Program Files/Microchip/xc8/v3.00/pic/include/proc/pic18f47k42.h"
+#include "../Common/power.h"
 
 //=============================================================================
 // GLOBAL VARIABLES DEFINITION
 //=============================================================================
-SystemState system_state = STATE_READY;
-unsigned char current_digit = 0;  // Currently displayed digit
-unsigned char tens_digit = 0;     // Stored tens digit
-unsigned char ones_digit = 0;     // Stored ones digit
-unsigned char entered_code = 0;   // Final entered code
-volatile bool emergency_active = false;
+// Task table, in the order the scheduler checks them
+Task tasks[TASK_COUNT] = {
+    {blink_d1,    0, false},  // TASK_BLINK
+    {unlock_task, 0, false},  // TASK_UNLOCK
+    {flash_task,  0, false},  // TASK_FLASH
+    {emergency_task, 0, false},  // TASK_EMERGENCY
+    {lockout_task, 0, false}   // TASK_LOCKOUT
+};
 
-// Global counters
-unsigned int debounce_counter = 0;
-unsigned char blink_counter = 0;  // Counter for blinking LED D1
+// Lock box transitions, the first row matching the state and event is taken.
+// Events without a row (the button while the motor runs, say) are ignored.
+const FsmTransition lock_transitions[] = {
+    {FSM_ANY,          EVENT_EMERGENCY, handle_emergency,     STATE_READY},
+    {STATE_READY,      EVENT_BUTTON,    start_code_entry,     STATE_CODE_INPUT},
+    {STATE_CODE_INPUT, EVENT_BUTTON,    process_button_press, STATE_READY},  // Stays for the next digit, STATE_UNLOCKED on a match
+    {STATE_CODE_INPUT, EVENT_PR1_COVER, process_pr1,          FSM_SAME},
+    {STATE_CODE_INPUT, EVENT_PR2_COVER, process_pr2,          FSM_SAME},
+    {STATE_UNLOCKED,   EVENT_RELOCKED,  0,                    STATE_READY}
+};
+
+Fsm lock_fsm = {lock_transitions, sizeof(lock_transitions) / sizeof(lock_transitions[0]), STATE_READY};
 
 
 void main(void) {
@@ -45,226 +91,18 @@ void main(void) {
     
     // Initial startup feedback
     beep(1); // Short beep
-    __delay_ms(100);
     beep(1); // Short beep
     
-    // Previous input states
-    bool prev_button = 1;  // Active-low (1 = not pressed)
-    bool prev_pr1 = 0;     // Previous PR1 state
-    bool prev_pr2 = 0;     // Previous PR2 state
-    
-    // Flags to track PR activation
-    bool pr1_activated = false;
-    bool pr2_activated = false;
-    
-    // Counter for system resets
-    unsigned int reset_counter = 0;
-    
+    // Start the periodic tasks
+    task_schedule(TASK_BLINK, BLINK_HALF_PERIOD_MS);
     
     while(1) { // main loop
-	
-        blink_d1();
-        
-        // Process emergency if active
-        if (emergency_active) {
-            system_state = STATE_READY;
-            current_digit = 0;
-            tens_digit = 0;
-            ones_digit = 0;
-            LATD = PATTERN_0;
-            reset_counter = 0;
-            pr1_activated = false;
-            pr2_activated = false;
-            
-            // Reset previous states
-            prev_pr1 = 0;
-            prev_pr2 = 0;
-            prev_button = 1;
-            
-            emergency_active = false;
-        }
-        
-        // Read inputs
-        bool button_state = PORTCbits.RC7;  // 0 when pressed (active-low)
-        bool pr1_state = PORTCbits.RC4;     // 1 when covered
-        bool pr2_state = PORTCbits.RC5;     // 1 when covered
-        
-        // Periodically reinitialize the pins
-        reset_counter++;
-        if (reset_counter >= 1000) {  // About every 20 seconds
-            // Reconfigure PR pins to ensure they're in correct state
-            ANSELC &= ~((1 << 4) | (1 << 5));  // Disable analog functionality for RC4/RC5
-            TRISCbits.TRISC4 = 1;  // RC4 input (PR1)
-            TRISCbits.TRISC5 = 1;  // RC5 input (PR2)
-            
-            // Reset flags
-            if (!pr1_state) pr1_activated = false;
-            if (!pr2_state) pr2_activated = false;
-            
-            reset_counter = 0;
-        }
-               
-        if (!button_state && prev_button) { // BUTTON PRESS DETECTION (active-low)
-            
-            beep(2);  // Audio feedback with medium beep
-                       
-            switch (system_state) { // Handle state transitions
-                case STATE_READY:
-                    system_state = STATE_TENS_INPUT;
-                    tens_digit = 0;
-                    current_digit = 0;
-                    LATD = PATTERN_0;
-                    
-                    // Reset PR flags
-                    pr1_activated = false;
-                    pr2_activated = false;
-                    prev_pr1 = 0;
-                    prev_pr2 = 0;
-                    break;
-                    
-                case STATE_TENS_INPUT:
-                    system_state = STATE_ONES_INPUT;
-                    ones_digit = 0;
-                    current_digit = 0;
-                    LATD = PATTERN_0;
-                    
-                    // Reset PR flags
-                    pr1_activated = false;
-                    pr2_activated = false;
-                    prev_pr1 = 0;
-                    prev_pr2 = 0;
-                    break;
-                    
-                case STATE_ONES_INPUT:
-                    // Form entered code
-                    entered_code = ((unsigned char)(tens_digit) << 4) | (unsigned char)(ones_digit);
-                                      
-                    if (entered_code == LOCKING_CODE) {  // Check if code matches
-                        // Success - Turn D1 solid, D2 off
-                        LED_D1_ON();
-                        LED_D2_OFF();
-                        
-                        beep(3);  // Success = long beep
-                        
-                        // Motor on for 5 seconds
-                        MOTOR_ON();
-                        __delay_ms(5000);
-                        MOTOR_OFF();
-                        
-                        // Reset to default
-                        LED_D1_OFF();  // Blinks in main loop
-                        LED_D2_ON();
-                    } else {
-                        
-                        LED_D2_ON(); // Incorrect code entered. Box stays locked
-                        
-                        // Failure beep
-                        BUZZER_ON();
-                        __delay_ms(2000);
-                        BUZZER_OFF();
-                    }
-                    
-                    // Reset state
-                    system_state = STATE_READY;
-                    current_digit = 0;
-                    LATD = PATTERN_0;
-                    
-                    // Reset flags after code check
-                    pr1_activated = false;
-                    pr2_activated = false;
-                    prev_pr1 = 0;
-                    prev_pr2 = 0;
-                    break;
-                    
-                default:
-                    system_state = STATE_READY;
-                    current_digit = 0;
-                    LATD = PATTERN_0;
-                    break;
-            }
-                       
-            __delay_ms(300); // Debounce delay
-        }
-               
-        if (system_state == STATE_TENS_INPUT) { // PR1 HANDLING - TENS DIGIT            
-            if (pr1_state && !prev_pr1 && !pr1_activated) { // Handle rising edge (PR1 just covered)               
-                if (tens_digit < 4) { // Increment tens digit
-                    tens_digit++;
-                } else {
-                    tens_digit = 0;
-                }
-                               
-                current_digit = tens_digit; // Update display
-                LATD = 0;  // Clear display briefly
-                __delay_ms(5);
-                switch (current_digit) {
-                    case 0: LATD = PATTERN_0; break;
-                    case 1: LATD = PATTERN_1; break;
-                    case 2: LATD = PATTERN_2; break;
-                    case 3: LATD = PATTERN_3; break;
-                    case 4: LATD = PATTERN_4; break;
-                    default: LATD = PATTERN_0; break;
-                }
-                               
-                LATAbits.LATA1 = 1; // Enabled 7-Segment ones digit
-                
-                beep(1);  // Short beep
-                               
-                pr1_activated = true; // Register as activated until PR1 is uncovered
-                                
-                __delay_ms(200); // Small delay for signal stabilization 
-            }
-                       
-            if (!pr1_state) { // Reset activation flag when PR1 is uncovered
-                pr1_activated = false;
-            }
-        }
-               
-        if (system_state == STATE_ONES_INPUT) { // PR2 HANDLING - ONES DIGIT
-            
-            if (pr2_state && !prev_pr2 && !pr2_activated) { // Handle rising edge (PR2 just covered)               
-                if (ones_digit < 4) { // Increment ones digit
-                    ones_digit++;
-                } else {
-                    ones_digit = 0;
-                }
-                                
-                current_digit = ones_digit; // Update display
-                LATD = 0;  // Clear display briefly
-                __delay_ms(5);
-                switch (current_digit) {
-                    case 0: LATD = PATTERN_0; break;
-                    case 1: LATD = PATTERN_1; break;
-                    case 2: LATD = PATTERN_2; break;
-                    case 3: LATD = PATTERN_3; break;
-                    case 4: LATD = PATTERN_4; break;
-                    default: LATD = PATTERN_0; break;
-                }
-                                
-                LATAbits.LATA1 = 1;
-                
-                // Visual feedback
-                LED_D2_OFF();
-                __delay_ms(50);
-                LED_D2_ON();
-                
-                beep(1);  // Audible feedback - Short beep
-                              
-                pr2_activated = true; // Rgistered as activated until PR2 is uncovered
-                               
-                __delay_ms(200); // Small delay for signal stabiliztion
-            }
-                       
-            if (!pr2_state) { // Reset activation flag when PR2 is uncovered
-                pr2_activated = false;
-            }
-        }
-        
-        // Update previous states at the end of each loop
-        prev_button = button_state;
-        prev_pr1 = pr1_state;
-        prev_pr2 = pr2_state;        
-        
-        __delay_ms(20); // Debounce
+        PROF_ENTER(PROF_LOOP);
+        scheduler_run();
+        PROF_EXIT(PROF_LOOP);
+        PROF_ENTER(PROF_FSM);
+        fsm_run(&lock_fsm);  // Events posted by the ISRs and tasks
+        PROF_EXIT(PROF_FSM);
+        POWER_IDLE_UNLESS(fsm_pending());  // Idle until the next tick or INT0
     }
 }
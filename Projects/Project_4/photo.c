@@ -0,0 +1,64 @@
+/*
+ * File: photo.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Photoresistor threshold front end on the shared ADC driver (photo.h).
+ */
+
+#include <xc.h>
+#include "photo.h"
+#include "../Common/adc.h"
+
+//=============================================================================
+// PHOTO STATE
+//=============================================================================
+static volatile unsigned char photo_channel = PHOTO_PR1;  // PR being converted (PHOTO_PR1 or PHOTO_PR2)
+static volatile bool photo_covered = false;               // Level of the selected PR, written by the ISR
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Set up the PR pins and the ADC, conversions start with the next Timer0 tick
+void photo_init(void) {
+    // Single conversions from the Timer0 tick, compared against the hysteresis levels
+    static const AdcConfig config = {PHOTO_ADCON2, PHOTO_ADCALC | PHOTO_TMD_COVER, 0, ADC_TRIGGER_TMR0};
+
+    ANSELC |= (1 << PHOTORESISTOR1_PIN) | (1 << PHOTORESISTOR2_PIN);  // RC4/RC5 analog
+    TRISCbits.TRISC4 = 1;  // RC4 input (PR1)
+    TRISCbits.TRISC5 = 1;  // RC5 input (PR2)
+
+    adc_set_thresholds(PHOTO_COVER_LEVEL, PHOTO_UNCOVER_LEVEL);
+    photo_select(PHOTO_PR1);  // Also enables the threshold interrupt
+
+    IPR1bits.ADTIP = 1;    // High priority, like INT0: both post events
+    adc_init(&config);
+}
+
+// Convert PHOTO_PR1 or PHOTO_PR2 from now on. The PR starts as uncovered, so one that is
+// already covered posts its cover event on the first conversion.
+void photo_select(unsigned char channel) {
+    adc_threshold_irq(false);  // No crossing while the channel changes
+    adc_select(channel, PHOTO_ADACQ);
+    photo_channel = channel;
+    photo_covered = false;
+    adc_set_mode(PHOTO_ADCALC | PHOTO_TMD_COVER);
+    adc_threshold_irq(true);
+}
+
+// Threshold crossing: flip the level, test for the opposite crossing next, post a cover
+void __interrupt(irq(IRQ_ADT), base(0x4008)) photo_ISR(void) {
+    PROF_ENTER(PROF_PHOTO);
+    PIR1bits.ADTIF = 0;    // Clear interrupt flag
+
+    photo_covered = !photo_covered;
+    if (photo_covered) {
+        adc_set_mode(PHOTO_ADCALC | PHOTO_TMD_UNCOVER);
+        fsm_post(photo_channel == PHOTO_PR1 ? EVENT_PR1_COVER : EVENT_PR2_COVER, 0);
+    } else {
+        adc_set_mode(PHOTO_ADCALC | PHOTO_TMD_COVER);
+    }
+    PROF_EXIT(PROF_PHOTO);
+}
@@ -0,0 +1,49 @@
+/*
+ * File: photo.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Analog front end for the photoresistors PR1 (RC4/ANC4) and PR2 (RC5/ANC5).
+ *          Timer0 triggers one ADC conversion of the selected PR every 1 ms and the ADC
+ *          threshold comparison raises an interrupt only when the reading crosses a level:
+ *          above PHOTO_COVER_LEVEL while uncovered, below PHOTO_UNCOVER_LEVEL while covered.
+ *          The gap between the two levels is the hysteresis. The ISR posts a cover event,
+ *          so nothing polls the pins and the thresholds no longer depend on the input buffer.
+ *          The ADC set-up is the shared Common/adc.h, the channels and levels are set here.
+ */
+
+#ifndef PHOTO_H
+#define PHOTO_H
+
+#include <xc.h>
+#include <stdbool.h>
+#include "config.h"
+#include "initialize.h"
+#include "events.h"
+
+//=============================================================================
+// ADC DEFINITIONS
+//=============================================================================
+
+// Thresholds in 12-bit counts (4096 = VDD), the reading rises when a PR is covered
+#define PHOTO_COVER_LEVEL   2250    // Covered once the reading goes above this (~2.75 V)
+#define PHOTO_UNCOVER_LEVEL 1850    // Uncovered once the reading goes below this (~2.26 V)
+
+#define PHOTO_PR1           0x14    // ADPCH code for ANC4 (RC4)
+#define PHOTO_PR2           0x15    // ADPCH code for ANC5 (RC5)
+
+#define PHOTO_ADCON2        0x00    // Basic mode, no accumulation
+#define PHOTO_ADCALC        0x10    // ADERR = ADRES - ADSTPT, with ADSTPT = 0 the reading itself
+#define PHOTO_TMD_COVER     0x06    // Threshold interrupt if ADERR > ADUTH
+#define PHOTO_TMD_UNCOVER   0x01    // Threshold interrupt if ADERR < ADLTH
+#define PHOTO_ADACQ         0x08    // Acquisition time in ADCRC periods
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void photo_init(void);  // Set up the PR pins and the triggered ADC, after the tick timer
+void photo_select(unsigned char channel);  // Convert PHOTO_PR1 or PHOTO_PR2 from now on
+void __interrupt(irq(IRQ_ADT), base(0x4008)) photo_ISR(void);  // Threshold crossing
+
+#endif /* PHOTO_H */
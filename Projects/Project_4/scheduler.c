@@ -0,0 +1,66 @@
+/*
+ * File: scheduler.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Tick interrupt and task scheduler (scheduler.h).
+ */
+
+#include <xc.h>
+#include "scheduler.h"
+#include "../Common/timebase.h"
+#include "../Common/debounce.h"
+#include "../Common/buzzer.h"
+#include "../Common/timer.h"
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Start the 1 ms tick on Timer0 as a low priority interrupt
+void scheduler_init(void) {
+    IPR3bits.TMR0IP = 0;       // Low priority so INT0 can preempt the tick
+    timer_tick_init();         // Timer0 period match every 1 ms (Common/timer.h)
+}
+
+// Run a task after delay_ms ticks (0 = on the next scheduler pass)
+void task_schedule(TaskId id, unsigned int delay_ms) {
+    tasks[id].due = timebase_millis() + delay_ms;
+    tasks[id].armed = true;
+}
+
+// Stop a task from running
+void task_cancel(TaskId id) {
+    tasks[id].armed = false;
+}
+
+// Check if a task is waiting to run
+bool task_pending(TaskId id) {
+    return tasks[id].armed;
+}
+
+// Run every task that is due. Tasks are disarmed before they run and re-arm themselves.
+void scheduler_run(void) {
+    unsigned int now = timebase_millis();
+
+    for (unsigned char i = 0; i < TASK_COUNT; i++) {
+        if (tasks[i].armed && (int)(now - tasks[i].due) >= 0) {  // Wrap-safe deadline check
+            tasks[i].armed = false;
+            tasks[i].run();
+        }
+    }
+}
+
+// Tick interrupt service routine
+void __interrupt(irq(IRQ_TMR0), base(0x4008), low_priority) tick_ISR(void) {
+    PROF_ENTER(PROF_TICK);
+    PIR3bits.TMR0IF = 0;  // Clear interrupt flag
+    timebase_tick();      // Millisecond count
+    debounce_tick();      // Sample the input ports
+    if (debounce_fell(DEBOUNCE_PORTC, 1 << CONFIRM_PIN)) {  // Active-low, the tick owns the edge
+        fsm_post(EVENT_BUTTON, 0);
+    }
+    buzzer_tick();        // Step the buzzer sound
+    PROF_EXIT(PROF_TICK);
+}
@@ -0,0 +1,57 @@
+/*
+ * File: scheduler.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: 1 ms Timer0 tick and cooperative task scheduler for the security system.
+ *          The tick advances the shared millisecond timebase (Common/timebase.h) and
+ *          samples the input ports for the debouncer (Common/debounce.h), then posts a
+ *          debounced confirm button press to the state machine (events.h).
+ *          Each task runs one step of its state machine, re-arms itself with
+ *          task_schedule() and returns, so no task ever blocks the main loop.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <xc.h>
+#include <stdbool.h>
+#include "config.h"
+#include "initialize.h"
+#include "events.h"
+
+//=============================================================================
+// TASK DEFINITIONS
+//=============================================================================
+typedef enum {
+    TASK_BLINK,        // Blinks LED D1 while the box is locked
+    TASK_UNLOCK,       // Runs the unlock beep and motor sequence
+    TASK_FLASH,        // Restores LED D2 after a short flash
+    TASK_EMERGENCY,    // Runs the emergency melody and LED flash
+    TASK_LOCKOUT,      // Counts a code entry lockout down (lockout.h)
+    TASK_COUNT
+} TaskId;
+
+typedef struct {
+    void (*run)(void);     // Task step, called once when the task is due
+    unsigned int due;      // Tick at which the task is due
+    bool armed;            // Task is waiting to run
+} Task;
+
+//=============================================================================
+// GLOBAL VARIABLES
+//=============================================================================
+extern Task tasks[TASK_COUNT];            // Task table, defined in main.c
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void scheduler_init(void);  // Start the 1 ms tick
+void task_schedule(TaskId id, unsigned int delay_ms);  // Run a task after delay_ms ticks
+void task_cancel(TaskId id);  // Stop a task from running
+bool task_pending(TaskId id);  // Check if a task is waiting to run
+void scheduler_run(void);  // Run every task that is due
+void __interrupt(irq(IRQ_TMR0), base(0x4008), low_priority) tick_ISR(void);  // Tick interrupt
+
+#endif /* SCHEDULER_H */
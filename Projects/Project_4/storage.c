@@ -0,0 +1,251 @@
+/*
+ * File: storage.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Data EEPROM config block, event log and the NVM write queue (storage.h).
+ */
+
+#include <xc.h>
+#include "storage.h"
+
+//=============================================================================
+// GLOBAL VARIABLES DEFINITION
+//=============================================================================
+StorageConfig storage_config;
+unsigned int storage_counts[LOG_TYPES];
+volatile unsigned int storage_dropped = 0;
+unsigned char storage_streak = 0;
+
+//=============================================================================
+// STORAGE STATE
+//=============================================================================
+static unsigned char storage_slot = 0;         // Log slot of the next record
+static unsigned int storage_sequence = 0;      // Sequence number of the next record
+static volatile StorageWrite storage_queue[STORAGE_QUEUE_SIZE];
+static volatile unsigned char storage_head = 0;  // Written by the main loop only
+static volatile unsigned char storage_tail = 0;  // Written by storage_start() only
+static volatile bool storage_writing = false;    // A byte write is in progress
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Load the config block, find the newest log record and count the failed attempts since the
+// last unlock, call with interrupts off. An invalid config block is replaced by the defaults.
+void storage_init(void) {
+    unsigned char record[STORAGE_RECORD_SIZE];
+    unsigned int sequence;
+    bool found = false;
+
+    storage_head = 0;
+    storage_tail = 0;
+    storage_writing = false;
+
+    // Config block
+    for (unsigned char i = 0; i < sizeof(storage_config); i++) {
+        ((unsigned char *)&storage_config)[i] = storage_read(STORAGE_CONFIG_ADDR + i);
+    }
+    bool config_valid = storage_config.magic == STORAGE_CONFIG_MAGIC
+            && storage_config.version == STORAGE_CONFIG_VERSION
+            && storage_check(STORAGE_CRC_INIT, (const unsigned char *)&storage_config, sizeof(storage_config)) == 0
+            && storage_config.code_length >= 1 && storage_config.code_length <= CODE_MAX_LENGTH;
+
+    // Log: the valid record with the newest sequence number is the head
+    storage_slot = 0;
+    storage_sequence = 0;
+    for (unsigned char i = 0; i < LOG_TYPES; i++) {
+        storage_counts[i] = 0;
+    }
+    for (unsigned char slot = 0; slot < STORAGE_RECORDS; slot++) {
+        if (!storage_read_record(slot, record)) {
+            continue;              // Erased or cut by a reset
+        }
+        sequence = record[0] | ((unsigned int)record[1] << 8);
+        if (found && (int)(sequence - storage_sequence) < 0) {
+            continue;              // Older than the newest so far (wrap-safe)
+        }
+        found = true;
+        storage_sequence = sequence;
+        storage_slot = slot;
+        for (unsigned char i = 0; i < LOG_TYPES; i++) {
+            storage_counts[i] = record[3 + 2 * i] | ((unsigned int)record[4 + 2 * i] << 8);
+        }
+    }
+
+    // Walk back from the newest record while the sequence numbers follow on, up to an unlock
+    storage_streak = 0;
+    sequence = storage_sequence;
+    for (unsigned char n = 0, slot = storage_slot; found && n < STORAGE_RECORDS; n++) {
+        if (!storage_read_record(slot, record) || (record[0] | ((unsigned int)record[1] << 8)) != sequence
+                || record[2] == LOG_UNLOCK) {
+            break;
+        }
+        if (record[2] == LOG_FAILED && storage_streak < 0xFF) {
+            storage_streak++;
+        }
+        sequence--;
+        slot = (slot > 0) ? slot - 1 : STORAGE_RECORDS - 1;
+    }
+
+    if (found) { // Append after the newest record
+        storage_sequence++;
+        storage_slot = (storage_slot + 1 < STORAGE_RECORDS) ? storage_slot + 1 : 0;
+    }
+
+    // Byte write complete interrupt, low priority like the tick
+    IPR0bits.NVMIP = 0;
+    PIR0bits.NVMIF = 0;
+    PIE0bits.NVMIE = 1;
+
+    if (!config_valid) { // Defaults, the write starts now and goes on once interrupts are on
+        storage_config.magic = STORAGE_CONFIG_MAGIC;
+        storage_config.version = STORAGE_CONFIG_VERSION;
+        storage_config.locking_code = LOCKING_CODE;
+        storage_config.code_length = CODE_LENGTH;
+        storage_config_save();
+    }
+}
+
+// Read one EEPROM byte, takes one instruction cycle. No write may be running.
+unsigned char storage_read(unsigned int address) {
+    NVMCON1 = 0x00;                // REG = Data EEPROM
+    NVMADRH = (unsigned char)(address >> 8);
+    NVMADRL = (unsigned char)address;
+    NVMCON1bits.RD = 1;
+    return NVMDAT;
+}
+
+// Read a log slot into record[STORAGE_RECORD_SIZE]. Returns false if the slot holds no valid
+// record (erased, or cut by a reset). No write may be running.
+bool storage_read_record(unsigned char slot, unsigned char *record) {
+    unsigned int address = STORAGE_LOG_ADDR + (unsigned int)slot * STORAGE_RECORD_SIZE;
+
+    for (unsigned char i = 0; i < STORAGE_RECORD_SIZE; i++) {
+        record[i] = storage_read(address + i);
+    }
+    return storage_check(STORAGE_CRC_INIT ^ slot, record, STORAGE_RECORD_SIZE) == 0 && record[2] < LOG_TYPES;
+}
+
+// Check byte for a block: its CRC-8, MSB first, starting from seed. A block with its check
+// byte included returns 0 if it is intact. Bitwise, about 8 cycles a bit, so a boot scan of
+// the whole log costs a few milliseconds and no table space.
+unsigned char storage_check(unsigned char seed, const unsigned char *data, unsigned char length) {
+    unsigned char crc = seed;
+
+    while (length--) {
+        crc ^= *data++;
+        for (unsigned char bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (unsigned char)(crc << 1) ^ STORAGE_CRC_POLY : (unsigned char)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// Queue a block write from the main loop. Returns false and queues nothing if there is no
+// room for the whole block.
+bool storage_write(unsigned int address, const unsigned char *data, unsigned char length) {
+    unsigned char gie = INTCON0bits.GIEH;
+    unsigned char space;
+
+    INTCON0bits.GIEH = 0;          // storage_ISR() moves the tail and the busy flag
+    space = (storage_tail - storage_head - 1) & (STORAGE_QUEUE_SIZE - 1);
+    if (space < length) {
+        storage_dropped++;
+        INTCON0bits.GIEH = gie;
+        return false;
+    }
+    for (unsigned char i = 0; i < length; i++) {
+        storage_queue[storage_head].address = address + i;
+        storage_queue[storage_head].data = data[i];
+        storage_head = (storage_head + 1) & (STORAGE_QUEUE_SIZE - 1);
+    }
+    if (!storage_writing) {
+        storage_start();
+    }
+    INTCON0bits.GIEH = gie;
+    return true;
+}
+
+// Start the next queued byte write, from storage_ISR() or with interrupts off. Bytes that
+// already hold the value are taken off the queue without a write.
+void storage_start(void) {
+    unsigned char gie = INTCON0bits.GIEH;
+    unsigned int address;
+    unsigned char data;
+
+    while (storage_tail != storage_head) {
+        address = storage_queue[storage_tail].address;
+        data = storage_queue[storage_tail].data;
+        storage_tail = (storage_tail + 1) & (STORAGE_QUEUE_SIZE - 1);
+
+        if (storage_read(address) == data) {
+            continue;              // No wear, no 4 ms wait
+        }
+        NVMDAT = data;             // NVMCON1 and NVMADR were set up by the read
+        NVMCON1bits.WREN = 1;
+        INTCON0bits.GIEH = 0;      // The unlock sequence must not be interrupted
+        NVMCON2 = STORAGE_NVM_UNLOCK1;
+        NVMCON2 = STORAGE_NVM_UNLOCK2;
+        NVMCON1bits.WR = 1;
+        INTCON0bits.GIEH = gie;
+        storage_writing = true;
+        return;
+    }
+    storage_writing = false;
+}
+
+// Count an event and append its record to the log. Returns false if the queue had no room;
+// the count is kept and goes out with the next record.
+bool storage_log(LogType type) {
+    unsigned char record[STORAGE_RECORD_SIZE];
+    unsigned int address = STORAGE_LOG_ADDR + (unsigned int)storage_slot * STORAGE_RECORD_SIZE;
+
+    storage_counts[type]++;
+
+    record[0] = (unsigned char)storage_sequence;
+    record[1] = (unsigned char)(storage_sequence >> 8);
+    record[2] = type;
+    for (unsigned char i = 0; i < LOG_TYPES; i++) {
+        record[3 + 2 * i] = (unsigned char)storage_counts[i];
+        record[4 + 2 * i] = (unsigned char)(storage_counts[i] >> 8);
+    }
+    record[STORAGE_RECORD_SIZE - 1] = storage_check(STORAGE_CRC_INIT ^ storage_slot, record, STORAGE_RECORD_SIZE - 1);  // Written last
+
+    if (!storage_write(address, record, STORAGE_RECORD_SIZE)) {
+        return false;
+    }
+    storage_sequence++;
+    storage_slot = (storage_slot + 1 < STORAGE_RECORDS) ? storage_slot + 1 : 0;
+    return true;
+}
+
+// Write storage_config back to the EEPROM, with a new check byte. Returns false if the queue
+// had no room.
+bool storage_config_save(void) {
+    storage_config.check = storage_check(STORAGE_CRC_INIT, (const unsigned char *)&storage_config, sizeof(storage_config) - 1);
+    return storage_write(STORAGE_CONFIG_ADDR, (const unsigned char *)&storage_config, sizeof(storage_config));
+}
+
+// Check if writes are still pending
+bool storage_busy(void) {
+    return storage_writing;
+}
+
+// Drop the queued writes, e.g. before rewriting the same block. A byte write already started
+// completes and its interrupt finds the queue empty.
+void storage_discard(void) {
+    unsigned char gie = INTCON0bits.GIEH;
+
+    INTCON0bits.GIEH = 0;          // storage_ISR() moves the tail
+    storage_tail = storage_head;
+    INTCON0bits.GIEH = gie;
+}
+
+// Byte write complete: start the next one
+void __interrupt(irq(IRQ_NVM), base(0x4008), low_priority) storage_ISR(void) {
+    PIR0bits.NVMIF = 0;            // Clear interrupt flag
+    NVMCON1bits.WREN = 0;          // No write enabled between writes
+    storage_start();
+}
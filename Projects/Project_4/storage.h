@@ -0,0 +1,98 @@
+/*
+ * File: storage.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Persistent configuration and event log in the 1 KB Data EEPROM.
+ *          The config block (locking code and its length) is read once by storage_init() and used from the
+ *          RAM copy storage_config. Failed attempts, emergencies and unlocks are appended as
+ *          records to a ring of STORAGE_RECORDS slots, so every slot is rewritten only once per
+ *          STORAGE_RECORDS events. Each record carries all three counts, so the newest valid
+ *          record restores them at boot, and the records since the last unlock give the run of
+ *          failed attempts that the lockout (lockout.h) carries over a reset.
+ *          Writes never block: bytes go into a RAM queue, and the NVM interrupt starts the next
+ *          byte write when the last one (about 4 ms) completes. Bytes already holding the value
+ *          are skipped. A record's check byte is written last, so a record cut by a reset does
+ *          not pass the check and the previous one is used.
+ *          The check byte is a CRC-8 (polynomial 0x07), not a byte sum, so swapped or shifted
+ *          bytes are caught, and a record's CRC starts from its slot number, so a record read
+ *          back from the wrong slot fails too.
+ *
+ *          Record, 10 bytes, multi-byte fields little-endian:
+ *            sequence (2) | type (1) | failed (2) | emergency (2) | unlock (2) | check (1)
+ *          check is the CRC-8 of the first 9 bytes seeded with STORAGE_CRC_INIT ^ slot, so the CRC of
+ *          the whole record is 0. Erased (0xFF) and zeroed slots never pass.
+ */
+
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include <xc.h>
+#include <stdbool.h>
+#include "config.h"
+#include "initialize.h"
+
+//=============================================================================
+// STORAGE DEFINITIONS
+//=============================================================================
+#define STORAGE_CONFIG_ADDR     0x000   // Config block
+#define STORAGE_LOG_ADDR        0x010   // First log slot
+#define STORAGE_RECORD_SIZE     10      // Bytes per log record
+#define STORAGE_RECORDS         100     // Log slots, 1000 bytes up to 0x3F7
+#define STORAGE_QUEUE_SIZE      32      // Pending byte writes (power of two), three records
+#define STORAGE_CONFIG_MAGIC    0xA7    // First byte of a stored config block
+#define STORAGE_CONFIG_VERSION  3       // Layout and check byte of StorageConfig
+#define STORAGE_CRC_POLY        0x07    // CRC-8 x^8 + x^2 + x + 1
+#define STORAGE_CRC_INIT        0xFF    // CRC seed, log records fold their slot number in
+
+#define STORAGE_NVM_UNLOCK1     0x55    // NVMCON2 unlock sequence before WR
+#define STORAGE_NVM_UNLOCK2     0xAA
+
+// Logged events, also the index into storage_counts[]
+typedef enum {
+    LOG_FAILED,        // Incorrect code entered
+    LOG_EMERGENCY,     // Emergency button accepted
+    LOG_UNLOCK,        // Correct code, box opened
+    LOG_TYPES
+} LogType;
+
+// Config block, 6 bytes at STORAGE_CONFIG_ADDR
+typedef struct {
+    unsigned char magic;         // STORAGE_CONFIG_MAGIC
+    unsigned char version;       // STORAGE_CONFIG_VERSION
+    unsigned int locking_code;   // One digit per nibble, the first digit entered highest
+    unsigned char code_length;   // Digits in the code, 1 to CODE_MAX_LENGTH
+    unsigned char check;         // CRC-8 of the block, seeded with STORAGE_CRC_INIT
+} StorageConfig;
+
+// One queued byte write
+typedef struct {
+    unsigned int address;
+    unsigned char data;
+} StorageWrite;
+
+//=============================================================================
+// GLOBAL VARIABLES
+//=============================================================================
+extern StorageConfig storage_config;            // Config in use, loaded at boot
+extern unsigned int storage_counts[LOG_TYPES];  // Events logged since the EEPROM was new
+extern volatile unsigned int storage_dropped;   // Records and blocks lost to a full queue
+extern unsigned char storage_streak;            // Failed attempts logged since the last unlock, at boot
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void storage_init(void);  // Load the config and find the log head, call with interrupts off
+unsigned char storage_read(unsigned int address);  // Read one EEPROM byte, no write may be running
+bool storage_read_record(unsigned char slot, unsigned char *record);  // Read a log slot, no write may be running
+unsigned char storage_check(unsigned char seed, const unsigned char *data, unsigned char length);  // CRC-8 check byte for a block
+bool storage_write(unsigned int address, const unsigned char *data, unsigned char length);  // Queue a block write
+void storage_start(void);  // Start the next queued byte write
+bool storage_log(LogType type);  // Count an event and append its record
+bool storage_config_save(void);  // Write storage_config back to the EEPROM
+bool storage_busy(void);  // Check if writes are still pending
+void storage_discard(void);  // Drop the queued writes, the one in progress completes
+void __interrupt(irq(IRQ_NVM), base(0x4008), low_priority) storage_ISR(void);  // Byte write complete
+
+#endif /* STORAGE_H */
@@ -0,0 +1,106 @@
+/*
+ * File name: ADC_Scan.c
+ * Purpose: ADC channel scan sequencer (ADC_Scan.h)
+ * Author: Huy Nguyen
+ * Created on 10/14/2026
+ */
+
+#include <xc.h>
+#include "ADC_Scan.h"
+#include "functions.h"      // Convert_Lux()
+#include "../Common/adc.h"
+
+// Global variables
+const ScanChannel scanTable[SCAN_CHANNELS] = {  // ADC channels in scan order
+    {0x00, 8, {FILTER_MEDIAN3 | FILTER_AVERAGE, 3}, 0, Convert_Lux}  // SCAN_LIGHT: RA0/ANA0, 8 TAD, median + 8-sample average
+};
+ScanResult scanResults[SCAN_CHANNELS];  // Latest value and batch of each channel
+volatile unsigned char scanIndex = 0;   // Channel being converted
+
+void Scan_Select(unsigned char index) { // Point the ADC at a table entry, takes effect on the next trigger
+    scanIndex = index;
+    adc_select(scanTable[index].channel, scanTable[index].acquisition);
+}
+
+
+unsigned int Scan_Filter(unsigned int reading) { // Filter a burst average of the current channel, called from my_ISR only
+    return filter_step(&scanResults[scanIndex].filter, &scanTable[scanIndex].filter, reading);
+}
+
+
+void Scan_Store(unsigned int reading) { // Store a filtered burst average and move on, called from my_ISR only
+    ScanResult *r = &scanResults[scanIndex];
+
+    r->latest = reading;
+    r->sum += reading;
+    if (++r->count >= SCAN_BATCH) { // Batch complete, publish the sum
+        if (r->ready) {
+            r->overruns++;         // Main loop did not take the last one
+        }
+        r->batch = r->sum;
+        r->ready = 1;
+        r->sum = 0;
+        r->count = 0;
+    }
+
+    Scan_Select((scanIndex + 1 < SCAN_CHANNELS) ? scanIndex + 1 : 0);
+}
+
+
+void Scan_Flush(void) { // Drop the batches in progress and restart from the first channel, sampling stopped
+    for (unsigned char i = 0; i < SCAN_CHANNELS; i++) {
+        scanResults[i].sum = 0;
+        scanResults[i].count = 0;
+        scanResults[i].ready = 0;
+        filter_reset(&scanResults[i].filter);
+    }
+    Scan_Select(0);
+}
+
+
+unsigned char Scan_Pending(void) { // 1 if a channel has a batch waiting for Scan_Process()
+    for (unsigned char i = 0; i < SCAN_CHANNELS; i++) {
+        if (scanResults[i].ready) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+unsigned char Scan_Process(void) { // Convert the new batches, returns a bit per updated channel
+    unsigned char updated = 0;
+
+    for (unsigned char i = 0; i < SCAN_CHANNELS; i++) {
+        if (scanResults[i].ready) {
+            INTCON0bits.GIE = 0;   // The 32-bit sum is read in several instructions
+            unsigned long batch = scanResults[i].batch;
+            scanResults[i].ready = 0;
+            INTCON0bits.GIE = 1;
+
+            scanResults[i].value = Scan_Convert(i, (long)(batch / SCAN_BATCH));
+            updated |= 1 << i;
+        }
+    }
+    return updated;
+}
+
+
+long Scan_Latest(unsigned char index) { // Converted value of the last filtered burst, without waiting for a batch
+    INTCON0bits.GIE = 0;           // The 16-bit value is read in two instructions
+    unsigned int latest = scanResults[index].latest;
+    INTCON0bits.GIE = 1;
+
+    return Scan_Convert(index, latest);
+}
+
+
+long Scan_Convert(unsigned char index, long reading) { // Calibrate a reading of a table entry and convert it
+    reading += scanTable[index].offset;
+    if (reading < 0) {
+        reading = 0;
+    } else if (reading > 4095) {
+        reading = 4095;
+    }
+    return scanTable[index].convert((unsigned int)reading);
+}
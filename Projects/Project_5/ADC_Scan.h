@@ -0,0 +1,61 @@
+/*
+ * File name: ADC_Scan.h
+ * Purpose: ADC channel scan sequencer. scanTable[] (ADC_Scan.c) lists the channels, each with its
+ *          own acquisition time, filter, calibration offset and conversion function. Timer2 starts
+ *          one burst average per trigger, my_ISR runs it through the channel's filter with
+ *          Scan_Filter() (Common/filter.h), stores it with Scan_Store() and moves the ADC on to the
+ *          next channel, so every channel keeps its latest value and batch sum without the main
+ *          loop touching the ADC. Scan_Latest() converts the latest value for consumers that
+ *          follow changes, Scan_Process() the batch averages. Adding a sensor is one more table entry.
+ * Author: Huy Nguyen
+ * Created on 10/14/2026
+ */
+
+#ifndef ADC_SCAN_H
+#define ADC_SCAN_H
+
+#include <xc.h>
+#include "../Common/filter.h"
+
+// Scan definitions
+#define SCAN_CHANNELS 1            // Entries in scanTable[]
+#define SCAN_LIGHT 0               // Photoresistor on RA0
+#define SCAN_BATCH 300             // Bursts averaged per result (300 ms per channel at 1 kHz)
+
+typedef long (*ScanConvert)(unsigned int reading);  // Averaged reading to display units
+
+typedef struct {
+    unsigned char channel;         // ADPCH code
+    unsigned char acquisition;     // ADACQ in ADC clock periods
+    FilterConfig filter;           // Filter stages run on every burst in my_ISR
+    int offset;                    // Calibration, counts added to the averaged reading
+    ScanConvert convert;           // Conversion run by Scan_Process()
+} ScanChannel;
+
+typedef struct {
+    volatile unsigned int latest;  // Last filtered burst average, written by my_ISR
+    volatile unsigned long batch;  // Sum of the last complete batch, written by my_ISR
+    volatile unsigned char ready;  // 1 when batch is new, cleared by Scan_Process()
+    volatile unsigned int overruns;  // Batches replaced before the main loop took them
+    unsigned long sum;             // Batch in progress, my_ISR only
+    unsigned int count;
+    long value;                    // Converted result of the last batch
+    Filter filter;                 // Filter state, my_ISR only
+} ScanResult;
+
+// Global variables (defined in ADC_Scan.c)
+extern const ScanChannel scanTable[SCAN_CHANNELS];
+extern ScanResult scanResults[SCAN_CHANNELS];
+extern volatile unsigned char scanIndex;  // Channel being converted, written by my_ISR only
+
+// Function prototypes
+void Scan_Select(unsigned char index);
+unsigned int Scan_Filter(unsigned int reading);
+void Scan_Store(unsigned int reading);
+void Scan_Flush(void);
+unsigned char Scan_Pending(void);
+unsigned char Scan_Process(void);
+long Scan_Latest(unsigned char index);
+long Scan_Convert(unsigned char index, long reading);
+
+#endif /* ADC_SCAN_H */
@@ -12,67 +12,35 @@
 extern "C" {
 #endif
 
-// PIC18F47K42 Configuration Bit Settings
-
-// 'C' source line config statements
-
-// CONFIG1L
-#pragma config FEXTOSC = LP     // External Oscillator Selection (LP (crystal oscillator) optimized for 32.768 kHz; PFM set to low power)
-#pragma config RSTOSC = EXTOSC  // Reset Oscillator Selection (EXTOSC operating per FEXTOSC bits (device manufacturing default))
-
-// CONFIG1H
-#pragma config CLKOUTEN = OFF   // Clock out Enable bit (CLKOUT function is disabled)
-#pragma config PR1WAY = ON      // PRLOCKED One-Way Set Enable bit (PRLOCK bit can be cleared and set only once)
-#pragma config CSWEN = ON       // Clock Switch Enable bit (Writing to NOSC and NDIV is allowed)
-#pragma config FCMEN = ON       // Fail-Safe Clock Monitor Enable bit (Fail-Safe Clock Monitor enabled)
-
-// CONFIG2L
-#pragma config MCLRE = EXTMCLR  // MCLR Enable bit (If LVP = 0, MCLR pin is MCLR; If LVP = 1, RE3 pin function is MCLR )
-#pragma config PWRTS = PWRT_OFF // Power-up timer selection bits (PWRT is disabled)
-#pragma config MVECEN = ON      // Multi-vector enable bit (Multi-vector enabled, Vector table used for interrupts)
-#pragma config IVT1WAY = ON     // IVTLOCK bit One-way set enable bit (IVTLOCK bit can be cleared and set only once)
-#pragma config LPBOREN = OFF    // Low Power BOR Enable bit (ULPBOR disabled)
-#pragma config BOREN = SBORDIS  // Brown-out Reset Enable bits (Brown-out Reset enabled , SBOREN bit is ignored)
-
-// CONFIG2H
-#pragma config BORV = VBOR_2P45 // Brown-out Reset Voltage Selection bits (Brown-out Reset Voltage (VBOR) set to 2.45V)
-#pragma config ZCD = OFF        // ZCD Disable bit (ZCD disabled. ZCD can be enabled by setting the ZCDSEN bit of ZCDCON)
-#pragma config PPS1WAY = ON     // PPSLOCK bit One-Way Set Enable bit (PPSLOCK bit can be cleared and set only once; PPS registers remain locked after one clear/set cycle)
-#pragma config STVREN = ON      // Stack Full/Underflow Reset Enable bit (Stack full/underflow will cause Reset)
-#pragma config DEBUG = OFF      // Debugger Enable bit (Background debugger disabled)
-#pragma config XINST = OFF      // Extended Instruction Set Enable bit (Extended Instruction Set and Indexed Addressing Mode disabled)
-
-// CONFIG3L
-#pragma config WDTCPS = WDTCPS_31// WDT Period selection bits (Divider ratio 1:65536; software control of WDTPS)
-#pragma config WDTE = OFF       // WDT operating mode (WDT Disabled; SWDTEN is ignored)
-
-// CONFIG3H
-#pragma config WDTCWS = WDTCWS_7// WDT Window Select bits (window always open (100%); software control; keyed access not required)
-#pragma config WDTCCS = SC      // WDT input clock selector (Software Control)
-
-// CONFIG4L
-#pragma config BBSIZE = BBSIZE_512// Boot Block Size selection bits (Boot Block size is 512 words)
-#pragma config BBEN = OFF       // Boot Block enable bit (Boot block disabled)
-#pragma config SAFEN = OFF      // Storage Area Flash enable bit (SAF disabled)
-#pragma config WRTAPP = OFF     // Application Block write protection bit (Application Block not write protected)
-
-// CONFIG4H
-#pragma config WRTB = OFF       // Boot Block Write Protection bit (Boot Block not write-protected)
-#pragma config WRTC = OFF       // Configuration Register Write Protection bit (Configuration registers not write-protected)
-#pragma config WRTD = OFF       // Data EEPROM Write Protection bit (Data EEPROM not write-protected)
-#pragma config WRTSAF = OFF     // SAF Write protection bit (SAF not Write Protected)
-#pragma config LVP = ON         // Low Voltage Programming Enable bit (Low voltage programming enabled. MCLR/VPP pin function is MCLR. MCLRE configuration bit is ignored)
-
-// CONFIG5L
-#pragma config CP = OFF         // PFM and Data EEPROM Code Protection bit (PFM and Data EEPROM code protection disabled)
+// PIC18F47K42 configuration bits are in LCD_Config.c, compiled once
 
 // Include necessary standard headers
 #include <xc.h> // must have this
-#include "C:/Program Files/Microchip/xc8/v3.00/pic/include/proc/pic18f47k42.h"
 
-// Define crystal frequency and instruction cycle
-#define _XTAL_FREQ 4000000     // Oscillator frequency for _delay() functions
-#define FCY   _XTAL_FREQ/4
+#include "../Common/clock.h"  // _XTAL_FREQ and FCY from the clock profile
+
+// Modules switched off (Common/power.h), only Timer0, Timer2, the ADC, NVM, IOC, UART1 and DMA1 stay on
+#define POWER_PMD0        0x7A    // FVR, HLVD, CRC, SCAN, CLKR off
+#define POWER_PMD1        0xFA    // All timers except TMR0 and TMR2, SMT1 off
+#define POWER_PMD2        0x47    // DAC, CMP1, CMP2, ZCD off
+#define POWER_PMD3        0xFF    // CCP1-4, PWM5-8 off
+#define POWER_PMD4        0x17    // CWG1-3, NCO1 off
+#define POWER_PMD5        0x01    // DSM1 off
+#define POWER_PMD6        0x2F    // UART2, SPIs, I2Cs off (UART1 sends telemetry)
+#define POWER_PMD7        0x2F    // CLCs, DMA2 off (DMA1 feeds UART1)
+#include "../Common/power.h"
+
+// Millisecond timebase, ticked from tick_ISR in main.c (Common/timebase.h)
+#include "../Common/timebase.h"
+
+// Profiling ids for Common/prof.h, hooks compile out unless PROF_ENABLE is defined
+#define PROF_LOOP         0   // One main loop pass
+#define PROF_ISR          1   // my_ISR
+#define PROF_LCD_FLUSH    2   // lcd_flush_step() in the main loop
+#define PROF_SHOW         3   // Show_Light_Level()
+#include "../Common/prof.h"
+
+// LCD interface options for Common/lcd.h are set for the whole build in the Makefile (DEFS)
 
 #ifdef	__cplusplus
 }
@@ -0,0 +1,107 @@
+/*
+ * File name: Telemetry.c
+ * Purpose: Binary telemetry stream on UART1 TX, sent by DMA1 (Telemetry.h)
+ * Author: Huy Nguyen
+ * Created on 10/14/2026
+ */
+
+#include <xc.h>
+#include "Telemetry.h"
+
+// Global variables
+volatile unsigned int telemetryDropped = 0;   // Packets dropped on a busy DMA1
+
+// Stream state, my_ISR and the init only
+static unsigned char telemetryBuffer[2][TELEMETRY_BUFFER_SIZE];  // Packets, one half filled while DMA1 sends the other
+static unsigned char telemetryHalf = 0;        // Half being filled
+static unsigned char telemetryFill = 0;        // Bytes in that half
+static unsigned int telemetryIndex = 0;        // Sample index of the next packet
+static unsigned char telemetryFlags = 0;       // Flags for the next packet
+
+void Telemetry_Init(void) { // Set up UART1 TX on RC6 and DMA1, call with interrupts off
+    // UART1: 8-bit asynchronous, TX only
+    TRISCbits.TRISC6 = 0;
+    RC6PPS = TELEMETRY_PPS_U1TX;
+    U1CON0 = TELEMETRY_U1CON0;
+    U1CON2 = 0x00;             // Normal polarity, 1 stop bit, no flow control
+    U1BRGH = (unsigned char)(CLOCK_UART_BRG(TELEMETRY_BAUD) >> 8);
+    U1BRGL = (unsigned char)CLOCK_UART_BRG(TELEMETRY_BAUD);
+    U1CON1 = TELEMETRY_U1CON1;
+    PIE3bits.U1TXIE = 0;       // U1TXIF only triggers the DMA
+
+    // DMA1: buffer half -> U1TXB, one byte per U1TXIF
+    DMA1CON0 = 0x00;
+    DMA1CON1 = TELEMETRY_DMA1CON1;
+    DMA1SSAU = 0x00;
+    DMA1DSAH = (unsigned char)((unsigned long)&U1TXB >> 8);
+    DMA1DSAL = (unsigned char)(unsigned long)&U1TXB;
+    DMA1DSZH = 0x00;
+    DMA1DSZL = 0x01;
+    DMA1SIRQ = TELEMETRY_IRQ_U1TX;
+    DMA1AIRQ = 0x00;
+
+    // System arbiter: DMA1 above the interrupts and the main code, then lock the priorities
+    DMA1PR = 0;
+    ISRPR = 1;
+    MAINPR = 2;
+    PRLOCK = 0x55;
+    PRLOCK = 0xAA;
+    PRLOCKbits.PRLOCKED = 1;
+
+    telemetryHalf = 0;
+    Telemetry_Restart();
+}
+
+
+void Telemetry_Restart(void) { // Start a new stream, with sampling stopped
+    telemetryFill = 0;
+    telemetryFlags = TELEMETRY_FLAG_RESTART;
+}
+
+
+void Telemetry_Sample(unsigned char channel, unsigned int raw, unsigned int filtered) { // Add a packet, called from my_ISR only
+    unsigned char *p = &telemetryBuffer[telemetryHalf][telemetryFill];
+    unsigned char check;
+
+    if (scanResults[channel].overruns) {
+        telemetryFlags |= TELEMETRY_FLAG_OVERRUN;
+    }
+
+    p[0] = TELEMETRY_SYNC1;
+    p[1] = TELEMETRY_SYNC2;
+    p[2] = (unsigned char)telemetryIndex;
+    p[3] = (unsigned char)(telemetryIndex >> 8);
+    p[4] = channel;
+    p[5] = (unsigned char)raw;
+    p[6] = (unsigned char)(raw >> 8);
+    p[7] = (unsigned char)filtered;
+    p[8] = (unsigned char)(filtered >> 8);
+    p[9] = telemetryFlags;
+    check = p[2] + p[3] + p[4] + p[5] + p[6] + p[7] + p[8] + p[9];
+    p[10] = (unsigned char)-check;
+
+    telemetryIndex++;
+    telemetryFlags = 0;
+    telemetryFill += TELEMETRY_PACKET_SIZE;
+
+    if (telemetryFill >= TELEMETRY_BUFFER_SIZE) { // Half full, hand it to DMA1
+        telemetryFill = 0;
+        if (DMA1CON0bits.SIRQEN) { // Other half still going out: drop this one
+            telemetryDropped += TELEMETRY_PACKETS;
+            telemetryFlags = TELEMETRY_FLAG_DROPPED;
+        } else {
+            Telemetry_Send(telemetryHalf);
+            telemetryHalf ^= 1;
+        }
+    }
+}
+
+
+void Telemetry_Send(unsigned char half) { // Start DMA1 on a buffer half, it stops by itself at the end
+    DMA1CON0 = 0x00;
+    DMA1SSAH = (unsigned char)((unsigned long)telemetryBuffer[half] >> 8);
+    DMA1SSAL = (unsigned char)(unsigned long)telemetryBuffer[half];
+    DMA1SSZH = 0x00;
+    DMA1SSZL = TELEMETRY_BUFFER_SIZE;
+    DMA1CON0 = TELEMETRY_DMA1CON0;  // The UART is idle, so U1TXIF starts the transfer at once
+}
@@ -0,0 +1,53 @@
+/*
+ * File name: Telemetry.h
+ * Purpose: Binary telemetry stream of every ADC scan sample on UART1 TX (RC6), sent by DMA1.
+ *          my_ISR adds a packet per burst with Telemetry_Sample(). Packets are collected in one
+ *          half of a double buffer while DMA1 sends the other half to U1TXB, one byte each time
+ *          the UART raises U1TXIF, so the CPU cost is building the packet. A half is dropped whole
+ *          (and the next packet flagged) if the other half is still being sent.
+ *
+ *          Packet, 11 bytes, multi-byte fields little-endian:
+ *            0xA5 0x5A | index (2) | channel (1) | raw (2) | filtered (2) | flags (1) | check (1)
+ *          index counts samples of all channels, raw is the burst average from ADFLTR, filtered
+ *          is the output of the channel's filter (scanTable[]) and check makes the byte sum from
+ *          index to check 0 mod 256.
+ * Author: Huy Nguyen
+ * Created on 10/14/2026
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <xc.h>
+#include "LCD_Config.h"
+#include "ADC_Scan.h"
+
+// UART and DMA definitions
+#define TELEMETRY_BAUD 250000UL        // 25 kB/s, a 1 kHz stream of packets uses 44 %
+#define TELEMETRY_U1CON0 0xA0          // High speed baud generator (BRGS), TX on, 8-bit async
+#define TELEMETRY_U1CON1 0x80          // UART on
+#define TELEMETRY_PPS_U1TX 0x13        // RxyPPS output code for UART1 TX
+#define TELEMETRY_IRQ_U1TX 0x1C        // DMA start trigger: U1TXIF (PIR3 bit 4)
+#define TELEMETRY_DMA1CON1 0x03        // Destination fixed, source in GPR incrementing, stop at the end
+#define TELEMETRY_DMA1CON0 0xC0        // DMA1 on, start trigger enabled
+
+// Packet definitions
+#define TELEMETRY_SYNC1 0xA5
+#define TELEMETRY_SYNC2 0x5A
+#define TELEMETRY_PACKET_SIZE 11
+#define TELEMETRY_PACKETS 8            // Packets per buffer half, 8 ms of samples at 1 kHz
+#define TELEMETRY_BUFFER_SIZE (TELEMETRY_PACKET_SIZE * TELEMETRY_PACKETS)
+#define TELEMETRY_FLAG_DROPPED 0x01    // Packets were dropped before this one
+#define TELEMETRY_FLAG_RESTART 0x02    // First packet after start-up or a halt
+#define TELEMETRY_FLAG_OVERRUN 0x04    // The channel has lost batches in Scan_Process()
+
+// Global variables (defined in Telemetry.c)
+extern volatile unsigned int telemetryDropped;  // Packets dropped because DMA1 was still busy
+
+// Function prototypes
+void Telemetry_Init(void);
+void Telemetry_Restart(void);
+void Telemetry_Sample(unsigned char channel, unsigned int raw, unsigned int filtered);
+void Telemetry_Send(unsigned char half);
+
+#endif /* TELEMETRY_H */
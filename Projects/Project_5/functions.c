@@ -0,0 +1,93 @@
+/* 
+ * File name: functions.c
+ * Purpose: Operation functions for the photoresistor light measurement project (functions.h)
+ * Author: Huy Nguyen 
+ * Created on 04/26/2025
+ */
+
+#include <xc.h>
+#include "functions.h"
+#include "../Common/timebase.h"
+#include "../Common/lcd.h"         // LCD on PORTB data, RS/EN/RW on RD0-RD2 (the driver defaults)
+
+// Global variables
+long lumen;                        // Light intensity in lux x100
+unsigned char interruptTriggered = 0;  // Flag to indicate interrupt has occurred
+unsigned char systemState = 0;         // 0=normal, 1=halted
+const PublishConfig lightDisplayPolicy = {LIGHT_DELTA_X100, LIGHT_MIN_GAP_MS, LIGHT_MAX_AGE_MS};
+Publish lightDisplay;                   // Last light level shown
+
+void MSdelay(unsigned int val) {  // Wait at least val milliseconds on the Timer0 timebase, core idles meanwhile
+    timebase_delay_ms(val);  /* Interrupt time does not stretch it */
+}
+
+
+long Convert_Lux(unsigned int reading) { // Light sensor conversion for scanTable[], lux x100 from the calibration line
+    long lux = LUX_B_X100 - (long)(((unsigned long)reading * LUX_M_Q12) >> 12);
+    
+    return (lux < 0) ? 0 : lux;  // Above 4.96 V the line goes below 0 lux
+}
+
+
+unsigned char Update_Light_Level(void) { // Redraw the light level if lightDisplayPolicy says so, returns 1 if it did
+    if (!publish_allowed(&lightDisplay, &lightDisplayPolicy)) {
+        return 0;          // Rate cap, skip the conversion too
+    }
+    long lux = Scan_Latest(SCAN_LIGHT);
+    if (!publish_due(&lightDisplay, &lightDisplayPolicy, lux)) {
+        return 0;          // Steady reading
+    }
+    lumen = lux;
+    Show_Light_Level();
+    return 1;
+}
+
+
+void Show_Light_Level(void) { // Display the light level in lumen
+    PROF_ENTER(PROF_SHOW);
+    lcd_buffer_fixed(2, 3, LIGHT_FIELD_WIDTH, lumen, 2);  // Up to "1498.30", no printf
+    lcd_buffer_string_xy(2, 3 + LIGHT_FIELD_WIDTH, " lux");
+    PROF_EXIT(PROF_SHOW);
+}
+
+
+void Handle_System_Halt(void) { // Handle system halt state when interrupt is triggered
+    unsigned int haltCounter = 0;
+    
+    T2CONbits.ON = 0;     // Stop sampling while halted
+    
+    // System has been interrupted - enter halt state
+    lcd_buffer_clear();    // Clear display
+    lcd_buffer_string_xy(1, 0, "SYSTEM HALTED");
+    lcd_buffer_string_xy(2, 0, "For 10 seconds");
+    lcd_flush();
+    
+    // LED blink for 10 seconds (20 blinks)
+    for (haltCounter = 0; haltCounter < 20; haltCounter++) {
+        LATCbits.LATC3 = 1;       // LED ON 
+        MSdelay(250);                        
+        LATCbits.LATC3 = 0;       // LED OFF
+        MSdelay(250);          
+    }
+    
+    // Reset system 
+    interruptTriggered = 0;
+    systemState = 0;       // Reset system state
+    LATCbits.LATC3 = 0;    // Ensure LED is off
+    
+    // Clear any pending interrupt flags
+    IOCCFbits.IOCCF2 = 0;
+    PIR0bits.IOCIF = 0;
+    
+    // Return to normal display
+    lcd_buffer_clear();    // Clear display again to ensure it's cleared
+    lcd_buffer_string_xy(1, 0, "Input light:");
+    lcd_buffer_string_xy(2, 3, "Resuming...");
+    lcd_flush();
+    MSdelay(1000);         // Show "Resuming..." for 1 second
+        
+    Scan_Flush();         // Discard batches started before the halt
+    Telemetry_Restart();  // Flag the gap in the stream
+    publish_reset(&lightDisplay);  // Show the first fresh reading after the rate cap
+    T2CONbits.ON = 1;     // Restart sampling
+}
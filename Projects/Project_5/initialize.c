@@ -0,0 +1,116 @@
+/* 
+ * File name: initialize.c
+ * Purpose: Initialization functions for the photoresistor light measurement project (initialize.h)
+ * Author: Huy Nguyen 
+ * Created on 04/26/2025
+ */
+
+#include <xc.h>
+#include "initialize.h"
+#include "functions.h" // MSdelay(), the scan and publish state
+#include "../Common/lcd.h"
+#include "../Common/adc.h"
+#include "../Common/timer.h"
+
+void Interrupt_Init(void) { // Initialize and configure the interrupt system
+    // 1. Disable all interrupts during configuration
+    INTCON0bits.GIE = 0;
+    
+    // 2. Configure RC3 as output for LED with initial state off
+    TRISCbits.TRISC3 = 0;     // Set RC3 as output
+    LATCbits.LATC3 = 0;       // Initialize LED as off
+    ODCONCbits.ODCC3 = 0;     // Disable open drain on LED pin
+    ANSELCbits.ANSELC3 = 0;   // Make sure RC3 is digital
+    
+    // 3. Configure RC2 as input for button with proper characteristics
+    TRISCbits.TRISC2 = 1;      // Set RC2 as input
+    ANSELCbits.ANSELC2 = 0;    // CRUCIAL: Set RC2 as digital (not analog)
+    WPUCbits.WPUC2 = 1;        // Enable weak pull-up
+    INLVLCbits.INLVLC2 = 1;    // Set input level to ST (Schmitt Trigger)
+    SLRCONCbits.SLRC2 = 0;     // Disable slew rate limiting
+    ODCONCbits.ODCC2 = 0;      // Disable open drain
+    
+    // 4. Set up the Interrupt Vector Table base address
+    IVTBASEU = 0x00;           // Upper byte of IVT base address
+    IVTBASEH = 0x60;           // High byte of IVT base address
+    IVTBASEL = 0x08;           // Low byte of IVT base address
+    
+    // 5. Configure IOC (Interrupt-On-Change) for RC2
+    IOCCFbits.IOCCF2 = 0;      // Clear any pending flag
+    PIE0bits.IOCIE = 0;        // Disable IOC interrupts while configuring
+    IOCCPbits.IOCCP2 = 1;      // Enable positive edge detection
+    IOCCNbits.IOCCN2 = 1;      // Enable negative edge detection
+    
+    // 6. Set up interrupt priority
+    IPR0bits.IOCIP = 1;        // High priority for IOC interrupts
+    IPR1bits.ADTIP = 1;        // ADC results are handled by my_ISR as well
+    
+    // 7. Enable IOC for PORTC and clear main IOC flag
+    PIR0bits.IOCIF = 0;        // Clear main IOC interrupt flag
+    PIE0bits.IOCIE = 1;        // Enable IOC interrupts
+    
+    // Enable the ADC burst complete (threshold) interrupt, the ISR fills the sample buffer
+    adc_threshold_irq(true);   // ADIE stays off, not needed for every single conversion
+    
+    // 8. Enable priority system and global interrupts
+    INTCON0bits.IPEN = 1;      // Enable interrupt priority
+    INTCON0bits.GIEH = 1;      // Enable high priority interrupts
+    INTCON0bits.GIEL = 1;      // Enable low priority interrupts
+    INTCON0bits.GIE = 1;       // Enable global interrupts
+}
+
+
+void ADC_Init(void) { // Initialize and configure the ADC
+    // Average a burst of conversions in hardware, each burst started by the sampling timer
+    static const AdcConfig config = {ADC_ADCON2, ADC_ADCON3, ADC_REPEAT, ADC_TRIGGER_TMR2};
+    
+    // Configure pin RA0 for analog input
+    TRISAbits.TRISA0 = 1;  // Set RA0 as input
+    ANSELAbits.ANSELA0 = 1; // Set RA0 as analog
+    
+    // Channel and acquisition time come from the scan table
+    Scan_Flush();
+    
+    // ADCRC clock, right justified, then the ADC is turned on (Common/adc.h)
+    adc_init(&config);
+    
+    // Short delay to allow ADC to stabilize
+    MSdelay(1);
+}
+
+
+void Sample_Timer_Init(void) { // Start Timer2 as the 1 kHz ADC trigger
+    timer2_init(SAMPLE_T2_CKPS, SAMPLE_T2PR);  // Conversions start from here
+}
+
+
+void System_Init(void) { // Initialize all peripherals and I/O ports
+    clock_init();  // Clock profile first, the delays and Timer2 depend on it
+    POWER_MODULES_OFF();  // Unused modules off before anything is set up
+    PROF_INIT();  // Trace pin and Timer1 cycle stamps in profiling builds
+    
+    // Disable all analog functionalities
+    ANSELA = 0;  ANSELB = 0; ANSELC = 0; ANSELD = 0;
+    
+    timer_tick_init();  // 1 ms tick (tick_ISR in main.c), the delays below need it
+    
+    Telemetry_Init();  // UART1 and DMA1, before interrupts are on
+    
+    Interrupt_Init();  // Initialize Interrupts
+        
+    lcd_init();  // Initialize LCD
+        
+    ADC_Init();  // Initialize ADC
+    
+    // Display initial message
+    lcd_buffer_clear();   // Clear display
+    lcd_buffer_string_xy(1, 0, "Input light:");
+    lcd_buffer_string_xy(2, 3, "Reading...");
+    lcd_flush();
+	MSdelay(2000);
+       
+    Scan_Flush();         // Start every channel on an empty batch
+    publish_reset(&lightDisplay);  // First reading shown once the rate cap has passed
+    
+    Sample_Timer_Init();  // Start continuous sampling
+}
@@ -7,9 +7,11 @@
  *      light intensity in lux. The program uses polling for continuous updates.
  * Input:  PORTA [0] - analog input to PIC from photoresistor
  *         PORTC [2] - control interrupt service routine
- * Output: PORTB [0 : 7] - output data to LCD display's pins D0-D7
+ * Output: PORTB [0 : 7] - output data to LCD display's pins D0-D7 (RB7:4 to D7-D4 in 4-bit mode)
  *         PORTC [3] - control interrupt indicator LED
  *         PORTD [0: 1] - control LCD display's Register Select and Enable pins 
+ *         PORTD [2] - control LCD display's Read/Write pin (busy flag polling)
+ *         PORTC [6] - UART1 TX telemetry stream
  * Author: Huy Nguyen 
  * Version: 1.0 04/21/2025 - Use 10KÎ© potentiometer to control input DC voltage to RA0. 
  *
@@ -25,25 +27,59 @@
  *
  *			1.2 04/24/2025 - Add ADC interrupt support.
  *			1.3 04/26/2025 - Create header files to streamline program.  
+ *			1.4 10/14/2026 - Timer2 triggers the ADC at 1 kHz (ADACT), the ADC ISR fills a ring buffer
+ *				and the main loop averages the samples in batches. No more 300 ms loop delay.
+ *			1.5 10/14/2026 - ADC burst average mode (8 conversions per trigger) and fixed-point conversion:
+ *				voltage (mV) = digital * 5000 / 4096 = (digital * 625) >> 9
+ *				lumen (lux x100) = 149830 - ((digital * 151000) >> 12), 151000 = 302 * 100 * 5000 mV / 1000
+ *				No float math or float printf left in the program.
+ *			1.6 10/14/2026 - LCD text goes to a 2x16 shadow buffer. The main loop sends one changed
+ *				character per pass, so a stable reading costs no LCD traffic.
+ *			1.7 10/14/2026 - LCD driver polls the busy flag through R/W (RD2) instead of fixed 1-3 ms
+ *				waits, optional 4-bit interface (LCD_4BIT_MODE in LCD_Config.h). All delays
+ *				now come from __delay_us/__delay_ms so they follow _XTAL_FREQ.
+ *			1.8 10/14/2026 - Core idles when no samples are pending and the LCD is up to date, unused
+ *				modules are switched off with PMD (Common/power.h).
+ *			1.9 10/14/2026 - System clock from the Common/clock.h profiles (HFINTOSC, no crystal),
+ *				_XTAL_FREQ and the sampling timer prescaler follow the selected profile.
+ *			2.0 10/14/2026 - Millisecond timebase on Timer0 (Common/timebase.h), MSdelay() and the
+ *				halt/resume waits run on it and idle the core instead of counting cycles.
+ *			2.1 10/14/2026 - ADC channel scan sequencer (ADC_Scan.h): scanTable[] gives each channel its
+ *				acquisition time, offset and conversion, my_ISR steps through the table and keeps
+ *				the latest value and batch sum per channel. Read_Voltage/Read_Light_Level and the
+ *				sample ring are replaced by Convert_Lux() and Show_Light_Level().
+ *			2.2 10/14/2026 - Profiling hooks (Common/prof.h) in my_ISR, LCD_String_xy(), Show_Light_Level()
+ *				and the main loop, compiled out unless PROF_ENABLE is defined.
+ *			2.3 10/14/2026 - Binary telemetry of every scan sample on UART1 TX (RC6) at 250 kbaud, packets
+ *				built by my_ISR in a double buffer and sent by DMA1 (Telemetry.h).
+ *			2.4 10/14/2026 - Per-channel integer filter stage (Common/filter.h) between the ADC and the
+ *				consumers: the light channel runs a 3-tap median and an 8-sample moving average,
+ *				the batch average, display and telemetry all see the filtered value.
+ *			2.5 10/14/2026 - The light level is redrawn when it changes by 1.5 lux or after 2 s, at most
+ *				every 100 ms (Common/publish.h), from the latest filtered reading instead of every
+ *				300 ms batch. A steady reading costs no formatting and no LCD traffic.
+ *			2.6 10/14/2026 - The lux value is formatted right-aligned into a fixed field of the shadow
+ *				buffer with Common/fmt.h. sprintf, <stdio.h> and the data[] string are gone.
+ *			2.7 10/14/2026 - LCD driver moved to the shared Common/lcd.h (lcd_init(), lcd_buffer_*(),
+ *				lcd_flush_step()) with its shadow buffer, out of functions.h and main.c. The
+ *				profiling id of the unused LCD_String_xy() now times lcd_flush_step().
+ *			2.8 10/14/2026 - Modules compiled separately: functions.c, initialize.c, ADC_Scan.c and
+ *				Telemetry.c hold the bodies that were in the headers, the configuration bits are
+ *				in LCD_Config.c and initialize.h no longer includes functions.h. The ADC and
+ *				Timer2 set-up use the shared Common/adc.h and Common/timer.h, the Timer0 tick
+ *				is tick_ISR. LCD_4BIT_MODE and LCD_USE_BUSY_FLAG moved to the Makefile.
+ *				Each module defines its own variables, main.c keeps main() and the ISRs.
  *
  */
 
 #include <xc.h>
-#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include "C:/Program Files/Microchip/xc8/v3.00/pic/include/proc/pic18f47k42.h"
 #include "LCD_Config.h"
 #include "functions.h" 
 #include "initialize.h" 
-
-// Global variables
-int digital;                       // ADC result
-float voltage;                     // Converted voltage
-float lumen;                       // Light intensity in lumens
-char data[10];                     // String for LCD display
-unsigned char interruptTriggered = 0;  // Flag to indicate interrupt has occurred
-unsigned char systemState = 0;         // 0=normal, 1=halted
+#include "../Common/lcd.h"
+#include "../Common/adc.h"
 
 // Main function
 void main(void) {   
@@ -51,9 +87,18 @@ void main(void) {
        
     while(1) { // Main loop        
         if (systemState == 0) { // Check if in normal operating mode            
-            Read_Light_Level(); // Read and display light level
-                        
-            __delay_ms(300);  // Small delay for signal stabilization
+            PROF_ENTER(PROF_LOOP);
+            Scan_Process();       // Keep the batch averages current
+            Update_Light_Level(); // Redraw the light level on a change or when it gets old
+            
+            PROF_ENTER(PROF_LCD_FLUSH);
+            unsigned char flushed = !lcd_flush_step();  // Send one changed character
+            PROF_EXIT(PROF_LCD_FLUSH);
+            PROF_EXIT(PROF_LOOP);
+            
+            if (flushed) { // LCD up to date: idle until the next batch or the button
+                POWER_IDLE_UNLESS(Scan_Pending() || interruptTriggered);
+            }
         }
                 
         if (interruptTriggered && systemState == 1) { // Check if interrupt button was pressed
@@ -62,8 +107,15 @@ void main(void) {
     }
 }
 
+// Millisecond tick, Timer0 started by System_Init() (Common/timer.h)
+void __interrupt(irq(IRQ_TMR0), base(0x6008)) tick_ISR(void) {
+    PIR3bits.TMR0IF = 0;  // Clear interrupt flag
+    timebase_tick();
+}
+
 // Interrupt Service Routine
 void __interrupt(irq(default), base(0x6008)) my_ISR(void) {    
+    PROF_ENTER(PROF_ISR);
     if (PIR0bits.IOCIF) { // Check if IOC interrupt has occurred       
         if (IOCCFbits.IOCCF2) { // Check if specifically RC2 triggered it
             
@@ -82,7 +134,12 @@ void __interrupt(irq(default), base(0x6008)) my_ISR(void) {
         }
     }
         
-    if (PIR1bits.ADIF) { // Clear ADC interrupt flag if set       
-        PIR1bits.ADIF = 0;
+    if (PIR1bits.ADTIF) { // Burst of conversions complete, send and store it, scan the next channel
+        PIR1bits.ADTIF = 0;
+        unsigned int reading = adc_filtered();
+        unsigned int filtered = Scan_Filter(reading);
+        Telemetry_Sample(scanIndex, reading, filtered);
+        Scan_Store(filtered);
     }
+    PROF_EXIT(PROF_ISR);
 }
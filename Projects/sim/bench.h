@@ -0,0 +1,68 @@
+/*
+ * File: bench.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Host benchmark helpers for the bench_*.c programs. BENCH() runs a statement a
+ *          number of times against the simulated registers and prints the host time and the
+ *          delay cycles (the time the routine would block on the target) per call.
+ *          Include after the project under test, so its _XTAL_FREQ is known.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include <time.h>
+
+//=============================================================================
+// BENCH STATE
+//=============================================================================
+static volatile long benchSink;  // Store results here so the host compiler keeps the work
+
+//=============================================================================
+// BENCH MACRO
+//=============================================================================
+
+// Run statement calls times and print one result line
+#define BENCH(name, calls, statement) do {                                  \
+    struct timespec benchStart, benchEnd;                                   \
+    unsigned long benchCycles = simCycles;                                  \
+    unsigned long benchCall;                                                \
+    clock_gettime(CLOCK_MONOTONIC, &benchStart);                            \
+    for (benchCall = 0; benchCall < (calls); benchCall++) {                 \
+        statement;                                                          \
+    }                                                                       \
+    clock_gettime(CLOCK_MONOTONIC, &benchEnd);                              \
+    bench_report((name), (calls), &benchStart, &benchEnd, simCycles - benchCycles); \
+} while (0)
+
+//=============================================================================
+// FUNCTION DECLARATIONS
+//=============================================================================
+void bench_header(const char *project);  // Print the table header
+void bench_report(const char *name, unsigned long calls, const struct timespec *start,
+                  const struct timespec *end, unsigned long cycles);  // Print one result
+
+//=============================================================================
+// FUNCTION IMPLEMENTATIONS
+//=============================================================================
+
+// Print the table header
+void bench_header(const char *project) {
+    printf("%s, Fosc %lu Hz\n", project, (unsigned long)_XTAL_FREQ);
+    printf("%-32s %12s %14s %12s\n", "routine", "ns/call", "delay cyc/call", "delay us");
+}
+
+// Print one result: host time per call and the simulated delay per call
+void bench_report(const char *name, unsigned long calls, const struct timespec *start,
+                  const struct timespec *end, unsigned long cycles) {
+    double ns = (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+    double perCall = (double)cycles / calls;
+
+    printf("%-32s %12.1f %14.0f %12.0f\n", name, ns / calls, perCall,
+           perCall * 4e6 / _XTAL_FREQ);
+}
+
+#endif /* BENCH_H */
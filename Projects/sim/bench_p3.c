@@ -0,0 +1,27 @@
+/*
+ * File: bench_p3.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Host benchmark of the Project_3 seven-segment calculator routines: the arithmetic,
+ *          the number-to-frame-buffer conversion, the display refresh interrupt and one key
+ *          press through the state machine.
+ *          Build and run from Projects/sim:  make bench_p3 && ./bench_p3
+ */
+
+#define main firmware_main             // The project's main() is not the entry point here
+#include "../Project_3/Part_2/calculatorSevenSeg.c"
+#undef main
+#include "bench.h"
+
+int main(void) {
+    bench_header("Project_3 Part_2");
+
+    BENCH("doOperation, A-D", 100000, benchSink = doOperation(benchCall % 10, 7, 0xA + (benchCall & 3)));
+    BENCH("encodeDigit", 100000, benchSink = encodeDigit(benchCall % 10));
+    BENCH("displayNumber", 100000, displayNumber((int)(benchCall % 199) - 99));
+    BENCH("displayISR", 100000, displayISR());
+    BENCH("postKey + fsm_run, digit", 100000, calc.state = CALC_NUM2; postKey(0); fsm_run(&calc));
+    return 0;
+}
@@ -0,0 +1,46 @@
+/*
+ * File: bench_p4.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Host benchmark of the Project_4 hot routines: the tick interrupt, the debouncer,
+ *          the event queue, the lock box state machine, the scheduler pass, the code check
+ *          and the EEPROM log queue.
+ *          Build and run from Projects/sim:  make bench_p4 && ./bench_p4
+ */
+
+#define main firmware_main             // The project's main() is not the entry point here
+#include "../Project_4/main.c"
+#undef main
+#include "../Common/timebase.h"
+#include "../Common/debounce.h"    // debouncePorts[], fed by tick_ISR in scheduler.c
+#include "../Common/buzzer.h"
+#include "bench.h"
+
+int main(void) {
+    FsmEvent event;
+    unsigned char data;
+
+    bench_header("Project_4");
+    debounce_init();
+
+    BENCH("tick_ISR", 100000, tick_ISR());
+    BENCH("debounce_sample, 3 ports", 100000,
+          debounce_sample(&debouncePorts[DEBOUNCE_PORTA], (unsigned char)benchCall);
+          debounce_sample(&debouncePorts[DEBOUNCE_PORTB], (unsigned char)(benchCall >> 2));
+          debounce_sample(&debouncePorts[DEBOUNCE_PORTC], (unsigned char)(benchCall >> 4)));
+    BENCH("fsm_post + fsm_get", 100000, fsm_post(EVENT_PR1_COVER, 0); benchSink = fsm_get(&event));
+    BENCH("display_digit", 100000, display_digit(benchCall % 5));
+    BENCH("fsm_run, no event", 100000, fsm_run(&lock_fsm));
+    BENCH("fsm_run, PR1 cover", 100000,
+          lock_fsm.state = STATE_CODE_INPUT; code_position = 0; fsm_post(EVENT_PR1_COVER, 0); fsm_run(&lock_fsm); buzzer_stop());
+    BENCH("scheduler_run", 100000, timebase_tick(); scheduler_run());
+    BENCH("code_submit, wrong code", 100000,
+          lockout_init(0); benchSink = code_submit(0x0044); storage_discard());
+    BENCH("storage_log, queue a record", 100000,
+          benchSink = storage_log(LOG_FAILED); storage_discard());
+    BENCH("storage_write + ISR, one byte", 100000,
+          data = (unsigned char)benchCall; storage_write(STORAGE_LOG_ADDR, &data, 1); storage_ISR());
+    return 0;
+}
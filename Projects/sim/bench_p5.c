@@ -0,0 +1,39 @@
+/*
+ * File: bench_p5.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Host benchmark of the Project_5 hot routines: the light conversion, the ADC scan
+ *          store and telemetry packet run by my_ISR, the display publish policy and the LCD shadow buffer and flush path.
+ *          Build and run from Projects/sim:  make bench_p5 && ./bench_p5
+ */
+
+#define main firmware_main             // The project's main() is not the entry point here
+#include "../Project_5/main.c"
+#undef main
+#include "bench.h"
+
+int main(void) {
+    unsigned int reading = 0;
+
+    bench_header("Project_5");
+    Scan_Flush();
+
+    BENCH("Convert_Lux", 100000, benchSink = Convert_Lux(reading++ & 0x0FFF));
+    BENCH("Scan_Filter (my_ISR)", 100000, benchSink = Scan_Filter(reading++ & 0x0FFF));
+    BENCH("Scan_Store (my_ISR)", 100000, Scan_Store(reading++ & 0x0FFF));
+    BENCH("Telemetry_Sample (my_ISR)", 100000, Telemetry_Sample(SCAN_LIGHT, reading & 0x0FFF, reading & 0x0FFF); reading++);
+    BENCH("Scan_Process", 100000, scanResults[SCAN_LIGHT].ready = 1; benchSink = Scan_Process());
+    BENCH("Update_Light_Level, steady", 100000, timebaseMillis++; benchSink = Update_Light_Level());
+    BENCH("Update_Light_Level, changing", 100000,
+          timebaseMillis += LIGHT_MIN_GAP_MS; scanResults[SCAN_LIGHT].latest = (benchCall & 1) ? 1000 : 2000;
+          benchSink = Update_Light_Level());
+    BENCH("Show_Light_Level", 100000, Show_Light_Level());
+    BENCH("lcd_flush_step, idle", 100000, benchSink = lcd_flush_step());
+    BENCH("lcd_flush, 2 rows changed", 10000,
+          lcd_buffer_string_xy(1, 0, (benchCall & 1) ? "Input light:    " : "INPUT LIGHT:    ");
+          lcd_buffer_string_xy(2, 0, (benchCall & 1) ? "   123.45 lux   " : "   678.90 lux   ");
+          lcd_flush());
+    return 0;
+}
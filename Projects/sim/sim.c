@@ -0,0 +1,12 @@
+/*
+ * File: sim.c
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Definitions of the simulated registers and the simulation state declared in xc.h.
+ *          Link it into every bench once, next to the project's modules.
+ */
+
+#define SIM_DEFINE
+#include <xc.h>
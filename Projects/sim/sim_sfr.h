@@ -0,0 +1,304 @@
+/*
+ * File: sim_sfr.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: PIC18F47K42 special function registers used by the projects, as plain host
+ *          variables for the xc.h shim. A register with bit fields is a union, so xxx and
+ *          xxxbits share one byte like on the device. Add a line here when a project uses
+ *          a register that is not listed yet.
+ */
+
+#ifndef SIM_SFR_H
+#define SIM_SFR_H
+
+SIM_SFR_BITS(ANSELA, unsigned ANSELA0:1; unsigned ANSELA1:1; unsigned ANSELA2:1; unsigned ANSELA3:1; unsigned ANSELA4:1; unsigned ANSELA5:1; unsigned ANSELA6:1; unsigned ANSELA7:1;)
+#define ANSELA sim_ANSELA.reg
+#define ANSELAbits sim_ANSELA.bits
+SIM_SFR(ANSELB)
+SIM_SFR_BITS(ANSELC, unsigned ANSELC0:1; unsigned ANSELC1:1; unsigned ANSELC2:1; unsigned ANSELC3:1; unsigned ANSELC4:1; unsigned ANSELC5:1; unsigned ANSELC6:1; unsigned ANSELC7:1;)
+#define ANSELC sim_ANSELC.reg
+#define ANSELCbits sim_ANSELC.bits
+SIM_SFR(ANSELD)
+SIM_SFR(ANSELE)
+SIM_SFR_BITS(LATA, unsigned LATA0:1; unsigned LATA1:1; unsigned LATA2:1; unsigned LATA3:1; unsigned LATA4:1; unsigned LATA5:1; unsigned LATA6:1; unsigned LATA7:1;)
+#define LATA sim_LATA.reg
+#define LATAbits sim_LATA.bits
+SIM_SFR_BITS(LATB, unsigned LATB0:1; unsigned LATB1:1; unsigned LATB2:1; unsigned LATB3:1; unsigned LATB4:1; unsigned LATB5:1; unsigned LATB6:1; unsigned LATB7:1;)
+#define LATB sim_LATB.reg
+#define LATBbits sim_LATB.bits
+SIM_SFR_BITS(LATC, unsigned LATC0:1; unsigned LATC1:1; unsigned LATC2:1; unsigned LATC3:1; unsigned LATC4:1; unsigned LATC5:1; unsigned LATC6:1; unsigned LATC7:1;)
+#define LATC sim_LATC.reg
+#define LATCbits sim_LATC.bits
+SIM_SFR_BITS(LATD, unsigned LATD0:1; unsigned LATD1:1; unsigned LATD2:1; unsigned LATD3:1; unsigned LATD4:1; unsigned LATD5:1; unsigned LATD6:1; unsigned LATD7:1;)
+#define LATD sim_LATD.reg
+#define LATDbits sim_LATD.bits
+SIM_SFR_BITS(LATE, unsigned LATE0:1; unsigned LATE1:1; unsigned LATE2:1; unsigned :5;)
+#define LATE sim_LATE.reg
+#define LATEbits sim_LATE.bits
+SIM_SFR_BITS(PORTA, unsigned RA0:1; unsigned RA1:1; unsigned RA2:1; unsigned RA3:1; unsigned RA4:1; unsigned RA5:1; unsigned RA6:1; unsigned RA7:1;)
+#define PORTA sim_PORTA.reg
+#define PORTAbits sim_PORTA.bits
+SIM_SFR_BITS(PORTB, unsigned RB0:1; unsigned RB1:1; unsigned RB2:1; unsigned RB3:1; unsigned RB4:1; unsigned RB5:1; unsigned RB6:1; unsigned RB7:1;)
+#define PORTB sim_PORTB.reg
+#define PORTBbits sim_PORTB.bits
+SIM_SFR_BITS(PORTC, unsigned RC0:1; unsigned RC1:1; unsigned RC2:1; unsigned RC3:1; unsigned RC4:1; unsigned RC5:1; unsigned RC6:1; unsigned RC7:1;)
+#define PORTC sim_PORTC.reg
+#define PORTCbits sim_PORTC.bits
+SIM_SFR(PORTD)
+SIM_SFR(PORTE)
+SIM_SFR_BITS(TRISA, unsigned TRISA0:1; unsigned TRISA1:1; unsigned TRISA2:1; unsigned TRISA3:1; unsigned TRISA4:1; unsigned TRISA5:1; unsigned TRISA6:1; unsigned TRISA7:1;)
+#define TRISA sim_TRISA.reg
+#define TRISAbits sim_TRISA.bits
+SIM_SFR_BITS(TRISB, unsigned TRISB0:1; unsigned TRISB1:1; unsigned TRISB2:1; unsigned TRISB3:1; unsigned TRISB4:1; unsigned TRISB5:1; unsigned TRISB6:1; unsigned TRISB7:1;)
+#define TRISB sim_TRISB.reg
+#define TRISBbits sim_TRISB.bits
+SIM_SFR_BITS(TRISC, unsigned TRISC0:1; unsigned TRISC1:1; unsigned TRISC2:1; unsigned TRISC3:1; unsigned TRISC4:1; unsigned TRISC5:1; unsigned TRISC6:1; unsigned TRISC7:1;)
+#define TRISC sim_TRISC.reg
+#define TRISCbits sim_TRISC.bits
+SIM_SFR_BITS(TRISD, unsigned TRISD0:1; unsigned TRISD1:1; unsigned TRISD2:1; unsigned TRISD3:1; unsigned TRISD4:1; unsigned TRISD5:1; unsigned TRISD6:1; unsigned TRISD7:1;)
+#define TRISD sim_TRISD.reg
+#define TRISDbits sim_TRISD.bits
+SIM_SFR_BITS(TRISE, unsigned TRISE0:1; unsigned TRISE1:1; unsigned TRISE2:1; unsigned :5;)
+#define TRISE sim_TRISE.reg
+#define TRISEbits sim_TRISE.bits
+SIM_SFR(WPUA)
+SIM_SFR(WPUB)
+SIM_SFR_BITS(WPUC, unsigned WPUC0:1; unsigned WPUC1:1; unsigned WPUC2:1; unsigned WPUC3:1; unsigned WPUC4:1; unsigned WPUC5:1; unsigned WPUC6:1; unsigned WPUC7:1;)
+#define WPUC sim_WPUC.reg
+#define WPUCbits sim_WPUC.bits
+SIM_SFR(WPUD)
+SIM_SFR(WPUE)
+SIM_SFR(IOCAP)
+SIM_SFR(IOCAN)
+SIM_SFR(IOCAF)
+SIM_SFR(IOCBP)
+SIM_SFR(IOCBN)
+SIM_SFR(IOCBF)
+SIM_SFR_BITS(IOCCP, unsigned IOCCP0:1; unsigned IOCCP1:1; unsigned IOCCP2:1; unsigned :5;)
+#define IOCCP sim_IOCCP.reg
+#define IOCCPbits sim_IOCCP.bits
+SIM_SFR_BITS(IOCCN, unsigned IOCCN0:1; unsigned IOCCN1:1; unsigned IOCCN2:1; unsigned :5;)
+#define IOCCN sim_IOCCN.reg
+#define IOCCNbits sim_IOCCN.bits
+SIM_SFR_BITS(IOCCF, unsigned IOCCF0:1; unsigned IOCCF1:1; unsigned IOCCF2:1; unsigned :5;)
+#define IOCCF sim_IOCCF.reg
+#define IOCCFbits sim_IOCCF.bits
+SIM_SFR(T0CON0)
+SIM_SFR(T0CON1)
+SIM_SFR(TMR0H)
+SIM_SFR(TMR0L)
+SIM_SFR_BITS(T1CON, unsigned ON:1; unsigned RD16:1; unsigned NOT_SYNC:1; unsigned :1; unsigned CKPS:2; unsigned :2;)
+#define T1CON sim_T1CON.reg
+#define T1CONbits sim_T1CON.bits
+SIM_SFR(T1CLK)
+SIM_SFR(T1GCON)
+SIM_SFR(TMR1H)
+SIM_SFR(TMR1L)
+SIM_SFR_BITS(T2CON, unsigned OUTPS:4; unsigned CKPS:3; unsigned ON:1;)
+#define T2CON sim_T2CON.reg
+#define T2CONbits sim_T2CON.bits
+SIM_SFR(T2CLKCON)
+SIM_SFR(T2HLT)
+SIM_SFR(T2PR)
+SIM_SFR(T2TMR)
+SIM_SFR(T2RST)
+SIM_SFR(IVTBASEU)
+SIM_SFR(IVTBASEH)
+SIM_SFR(IVTBASEL)
+SIM_SFR_BITS(ADCON0, unsigned GO:1; unsigned :1; unsigned FM:1; unsigned :1; unsigned CS:1; unsigned :1; unsigned CONT:1; unsigned ON:1;)
+#define ADCON0 sim_ADCON0.reg
+#define ADCON0bits sim_ADCON0.bits
+SIM_SFR(ADCON1)
+SIM_SFR(ADCON2)
+SIM_SFR(ADCON3)
+SIM_SFR(ADCLK)
+SIM_SFR(ADREF)
+SIM_SFR(ADPCH)
+SIM_SFR(ADACQL)
+SIM_SFR(ADACQH)
+SIM_SFR(ADRESH)
+SIM_SFR(ADRESL)
+SIM_SFR(ADACT)
+SIM_SFR(ADRPT)
+SIM_SFR(ADCNT)
+SIM_SFR(ADFLTRH)
+SIM_SFR(ADFLTRL)
+SIM_SFR(ADPREVH)
+SIM_SFR(ADPREVL)
+SIM_SFR(ADLTHH)
+SIM_SFR(ADLTHL)
+SIM_SFR(ADUTHH)
+SIM_SFR(ADUTHL)
+SIM_SFR(ADSTPTH)
+SIM_SFR(ADSTPTL)
+SIM_SFR(ADERRH)
+SIM_SFR(ADERRL)
+SIM_SFR(ADSTAT)
+SIM_SFR(ADPREL)
+SIM_SFR(ADPREH)
+SIM_SFR(ADCAP)
+SIM_SFR(CCP1CON)
+SIM_SFR(CCPR1H)
+SIM_SFR(CCPR1L)
+SIM_SFR(RA5PPS)
+SIM_SFR(RC6PPS)
+SIM_SFR_BITS(PPSLOCK, unsigned PPSLOCKED:1; unsigned :7;)
+#define PPSLOCK sim_PPSLOCK.reg
+#define PPSLOCKbits sim_PPSLOCK.bits
+SIM_SFR_BITS(PRLOCK, unsigned PRLOCKED:1; unsigned :7;)
+#define PRLOCK sim_PRLOCK.reg
+#define PRLOCKbits sim_PRLOCK.bits
+SIM_SFR_BITS(OSCCON1, unsigned NDIV:4; unsigned NOSC:3; unsigned :1;)
+#define OSCCON1 sim_OSCCON1.reg
+#define OSCCON1bits sim_OSCCON1.bits
+SIM_SFR(OSCFRQ)
+SIM_SFR(OSCEN)
+SIM_SFR_BITS(CPUDOZE, unsigned DOZE:3; unsigned :1; unsigned DOE:1; unsigned ROI:1; unsigned DOZEN:1; unsigned IDLEN:1;)
+#define CPUDOZE sim_CPUDOZE.reg
+#define CPUDOZEbits sim_CPUDOZE.bits
+SIM_SFR_BITS(FVRCON, unsigned ADFVR:2; unsigned CDAFVR:2; unsigned TSRNG:1; unsigned TSEN:1; unsigned FVRRDY:1; unsigned FVREN:1;)
+#define FVRCON sim_FVRCON.reg
+#define FVRCONbits sim_FVRCON.bits
+SIM_SFR_BITS(PMD0, unsigned IOCMD:1; unsigned CLKRMD:1; unsigned NVMMD:1; unsigned SCANMD:1; unsigned CRCMD:1; unsigned HLVDMD:1; unsigned FVRMD:1; unsigned SYSCMD:1;)
+#define PMD0 sim_PMD0.reg
+#define PMD0bits sim_PMD0.bits
+SIM_SFR_BITS(PMD1, unsigned TMR0MD:1; unsigned TMR1MD:1; unsigned TMR2MD:1; unsigned TMR3MD:1; unsigned TMR4MD:1; unsigned TMR5MD:1; unsigned TMR6MD:1; unsigned SMT1MD:1;)
+#define PMD1 sim_PMD1.reg
+#define PMD1bits sim_PMD1.bits
+SIM_SFR_BITS(PMD2, unsigned ZCDMD:1; unsigned CMP1MD:1; unsigned CMP2MD:1; unsigned :2; unsigned ADCMD:1; unsigned DACMD:1; unsigned :1;)
+#define PMD2 sim_PMD2.reg
+#define PMD2bits sim_PMD2.bits
+SIM_SFR_BITS(PMD3, unsigned CCP1MD:1; unsigned CCP2MD:1; unsigned CCP3MD:1; unsigned CCP4MD:1; unsigned PWM5MD:1; unsigned PWM6MD:1; unsigned PWM7MD:1; unsigned PWM8MD:1;)
+#define PMD3 sim_PMD3.reg
+#define PMD3bits sim_PMD3.bits
+SIM_SFR_BITS(PMD4, unsigned CWG1MD:1; unsigned CWG2MD:1; unsigned CWG3MD:1; unsigned :1; unsigned NCO1MD:1; unsigned :3;)
+#define PMD4 sim_PMD4.reg
+#define PMD4bits sim_PMD4.bits
+SIM_SFR_BITS(PMD5, unsigned DSM1MD:1; unsigned :7;)
+#define PMD5 sim_PMD5.reg
+#define PMD5bits sim_PMD5.bits
+SIM_SFR_BITS(PMD6, unsigned I2C1MD:1; unsigned I2C2MD:1; unsigned SPI1MD:1; unsigned SPI2MD:1; unsigned U1MD:1; unsigned U2MD:1; unsigned :2;)
+#define PMD6 sim_PMD6.reg
+#define PMD6bits sim_PMD6.bits
+SIM_SFR_BITS(PMD7, unsigned CLC1MD:1; unsigned CLC2MD:1; unsigned CLC3MD:1; unsigned CLC4MD:1; unsigned DMA1MD:1; unsigned DMA2MD:1; unsigned :2;)
+#define PMD7 sim_PMD7.reg
+#define PMD7bits sim_PMD7.bits
+SIM_SFR(U1CON0)
+SIM_SFR_BITS(U1CON1, unsigned SENDB:1; unsigned BRKOVR:1; unsigned :1; unsigned RXBIMD:1; unsigned :1; unsigned WUE:1; unsigned :1; unsigned ON:1;)
+#define U1CON1 sim_U1CON1.reg
+#define U1CON1bits sim_U1CON1.bits
+SIM_SFR(U1CON2)
+SIM_SFR(U1BRGL)
+SIM_SFR(U1BRGH)
+SIM_SFR(U1TXB)
+SIM_SFR(U1RXB)
+SIM_SFR_BITS(DMA1CON0, unsigned XIP:1; unsigned :1; unsigned AIRQEN:1; unsigned :1; unsigned DMA1DGO:1; unsigned DGO:1; unsigned SIRQEN:1; unsigned EN:1;)
+#define DMA1CON0 sim_DMA1CON0.reg
+#define DMA1CON0bits sim_DMA1CON0.bits
+SIM_SFR(DMA1CON1)
+SIM_SFR(DMA1SSAU)
+SIM_SFR(DMA1SSAH)
+SIM_SFR(DMA1SSAL)
+SIM_SFR(DMA1SSZH)
+SIM_SFR(DMA1SSZL)
+SIM_SFR(DMA1DSAH)
+SIM_SFR(DMA1DSAL)
+SIM_SFR(DMA1DSZH)
+SIM_SFR(DMA1DSZL)
+SIM_SFR(DMA1SIRQ)
+SIM_SFR(DMA1AIRQ)
+SIM_SFR(DMA1PR)
+SIM_SFR(MAINPR)
+SIM_SFR(ISRPR)
+SIM_SFR_BITS(NVMCON1, unsigned RD:1; unsigned WR:1; unsigned WREN:1; unsigned WRERR:1; unsigned FREE:1; unsigned :1; unsigned REG:2;)
+#define NVMCON1 sim_NVMCON1.reg
+#define NVMCON1bits sim_NVMCON1.bits
+SIM_SFR(NVMCON2)
+SIM_SFR(NVMADRL)
+SIM_SFR(NVMADRH)
+SIM_SFR(NVMDAT)
+SIM_SFR(WREG)
+SIM_SFR_BITS(INTCON0, unsigned INT0EDG:1; unsigned INT1EDG:1; unsigned INT2EDG:1; unsigned :2; unsigned IPEN:1; unsigned GIEL:1; unsigned GIE:1; unsigned GIEH:1;)
+#define INTCON0 sim_INTCON0.reg
+#define INTCON0bits sim_INTCON0.bits
+SIM_SFR(STATUS)
+SIM_SFR_BITS(PIR0, unsigned SWIF:1; unsigned HLVDIF:1; unsigned OSFIF:1; unsigned CSWIF:1; unsigned NVMIF:1; unsigned CLC1IF:1; unsigned CRCIF:1; unsigned IOCIF:1;)
+#define PIR0 sim_PIR0.reg
+#define PIR0bits sim_PIR0.bits
+SIM_SFR_BITS(PIE0, unsigned SWIE:1; unsigned HLVDIE:1; unsigned OSFIE:1; unsigned CSWIE:1; unsigned NVMIE:1; unsigned CLC1IE:1; unsigned CRCIE:1; unsigned IOCIE:1;)
+#define PIE0 sim_PIE0.reg
+#define PIE0bits sim_PIE0.bits
+SIM_SFR_BITS(IPR0, unsigned SWIP:1; unsigned HLVDIP:1; unsigned OSFIP:1; unsigned CSWIP:1; unsigned NVMIP:1; unsigned CLC1IP:1; unsigned CRCIP:1; unsigned IOCIP:1;)
+#define IPR0 sim_IPR0.reg
+#define IPR0bits sim_IPR0.bits
+SIM_SFR_BITS(PIR1, unsigned INT0IF:1; unsigned ZCDIF:1; unsigned ADIF:1; unsigned ADTIF:1; unsigned C1IF:1; unsigned SMT1IF:1; unsigned SMT1PRAIF:1; unsigned SMT1PWAIF:1;)
+#define PIR1 sim_PIR1.reg
+#define PIR1bits sim_PIR1.bits
+SIM_SFR_BITS(PIE1, unsigned INT0IE:1; unsigned ZCDIE:1; unsigned ADIE:1; unsigned ADTIE:1; unsigned C1IE:1; unsigned SMT1IE:1; unsigned SMT1PRAIE:1; unsigned SMT1PWAIE:1;)
+#define PIE1 sim_PIE1.reg
+#define PIE1bits sim_PIE1.bits
+SIM_SFR_BITS(IPR1, unsigned INT0IP:1; unsigned ZCDIP:1; unsigned ADIP:1; unsigned ADTIP:1; unsigned C1IP:1; unsigned SMT1IP:1; unsigned SMT1PRAIP:1; unsigned SMT1PWAIP:1;)
+#define IPR1 sim_IPR1.reg
+#define IPR1bits sim_IPR1.bits
+SIM_SFR_BITS(PIR2, unsigned DMA1SCNTIF:1; unsigned DMA1DCNTIF:1; unsigned DMA1ORIF:1; unsigned DMA1AIF:1; unsigned SPI1RXIF:1; unsigned SPI1TXIF:1; unsigned SPI1IF:1; unsigned I2C1RXIF:1;)
+#define PIR2 sim_PIR2.reg
+#define PIR2bits sim_PIR2.bits
+SIM_SFR_BITS(PIE2, unsigned DMA1SCNTIE:1; unsigned DMA1DCNTIE:1; unsigned DMA1ORIE:1; unsigned DMA1AIE:1; unsigned SPI1RXIE:1; unsigned SPI1TXIE:1; unsigned SPI1IE:1; unsigned I2C1RXIE:1;)
+#define PIE2 sim_PIE2.reg
+#define PIE2bits sim_PIE2.bits
+SIM_SFR_BITS(IPR2, unsigned DMA1SCNTIP:1; unsigned DMA1DCNTIP:1; unsigned DMA1ORIP:1; unsigned DMA1AIP:1; unsigned SPI1RXIP:1; unsigned SPI1TXIP:1; unsigned SPI1IP:1; unsigned I2C1RXIP:1;)
+#define IPR2 sim_IPR2.reg
+#define IPR2bits sim_IPR2.bits
+SIM_SFR_BITS(PIR3, unsigned I2C1TXIF:1; unsigned I2C1IF:1; unsigned I2C1EIF:1; unsigned U1RXIF:1; unsigned U1TXIF:1; unsigned U1EIF:1; unsigned U1IF:1; unsigned TMR0IF:1;)
+#define PIR3 sim_PIR3.reg
+#define PIR3bits sim_PIR3.bits
+SIM_SFR_BITS(PIE3, unsigned I2C1TXIE:1; unsigned I2C1IE:1; unsigned I2C1EIE:1; unsigned U1RXIE:1; unsigned U1TXIE:1; unsigned U1EIE:1; unsigned U1IE:1; unsigned TMR0IE:1;)
+#define PIE3 sim_PIE3.reg
+#define PIE3bits sim_PIE3.bits
+SIM_SFR_BITS(IPR3, unsigned I2C1TXIP:1; unsigned I2C1IP:1; unsigned I2C1EIP:1; unsigned U1RXIP:1; unsigned U1TXIP:1; unsigned U1EIP:1; unsigned U1IP:1; unsigned TMR0IP:1;)
+#define IPR3 sim_IPR3.reg
+#define IPR3bits sim_IPR3.bits
+SIM_SFR_BITS(PIR4, unsigned TMR1IF:1; unsigned TMR1GIF:1; unsigned TMR2IF:1; unsigned CCP1IF:1; unsigned :4;)
+#define PIR4 sim_PIR4.reg
+#define PIR4bits sim_PIR4.bits
+SIM_SFR_BITS(PIE4, unsigned TMR1IE:1; unsigned TMR1GIE:1; unsigned TMR2IE:1; unsigned CCP1IE:1; unsigned :4;)
+#define PIE4 sim_PIE4.reg
+#define PIE4bits sim_PIE4.bits
+SIM_SFR_BITS(IPR4, unsigned TMR1IP:1; unsigned TMR1GIP:1; unsigned TMR2IP:1; unsigned CCP1IP:1; unsigned :4;)
+#define IPR4 sim_IPR4.reg
+#define IPR4bits sim_IPR4.bits
+SIM_SFR_BITS(ODCONC, unsigned ODCC0:1; unsigned ODCC1:1; unsigned ODCC2:1; unsigned ODCC3:1; unsigned :4;)
+#define ODCONC sim_ODCONC.reg
+#define ODCONCbits sim_ODCONC.bits
+SIM_SFR_BITS(INLVLC, unsigned INLVLC0:1; unsigned INLVLC1:1; unsigned INLVLC2:1; unsigned :5;)
+#define INLVLC sim_INLVLC.reg
+#define INLVLCbits sim_INLVLC.bits
+SIM_SFR_BITS(SLRCONC, unsigned SLRC0:1; unsigned SLRC1:1; unsigned SLRC2:1; unsigned :5;)
+#define SLRCONC sim_SLRCONC.reg
+#define SLRCONCbits sim_SLRCONC.bits
+SIM_SFR_BITS(OSCCON3, unsigned :4; unsigned NOSCR:1; unsigned ORDY:1; unsigned SOSCPWR:1; unsigned CSWHOLD:1;)
+#define OSCCON3 sim_OSCCON3.reg
+#define OSCCON3bits sim_OSCCON3.bits
+SIM_SFR_BITS(OSCSTAT, unsigned PLLR:1; unsigned :1; unsigned ADOR:1; unsigned SOR:1; unsigned LFOR:1; unsigned MFOR:1; unsigned HFOR:1; unsigned EXTOR:1;)
+#define OSCSTAT sim_OSCSTAT.reg
+#define OSCSTATbits sim_OSCSTAT.bits
+SIM_SFR_BITS(U1FIFO, unsigned RXBF:1; unsigned RXBE:1; unsigned XON:1; unsigned RXIDL:1; unsigned TXBF:1; unsigned TXBE:1; unsigned STPMD:1; unsigned TXWRE:1;)
+#define U1FIFO sim_U1FIFO.reg
+#define U1FIFObits sim_U1FIFO.bits
+SIM_SFR_BITS(CCPTMRS0, unsigned C1TSEL:2; unsigned C2TSEL:2; unsigned C3TSEL:2; unsigned C4TSEL:2;)
+#define CCPTMRS0 sim_CCPTMRS0.reg
+#define CCPTMRS0bits sim_CCPTMRS0.bits
+
+// Single-bit names the projects use directly
+#define LATD0 LATDbits.LATD0
+#define LATD1 LATDbits.LATD1
+#define LATD2 LATDbits.LATD2
+#define LATD3 LATDbits.LATD3
+#define LATD4 LATDbits.LATD4
+#define LATD5 LATDbits.LATD5
+#define LATD6 LATDbits.LATD6
+#define LATD7 LATDbits.LATD7
+
+#endif /* SIM_SFR_H */
@@ -0,0 +1,61 @@
+/*
+ * File: xc.h
+ * Author: Huy Nguyen
+ *
+ * Created on October 14, 2026
+ *
+ * Purpose: Host stand-in for the XC8 <xc.h>, so the C projects compile natively with gcc for
+ *          simulation and benchmarking (gcc -I Projects/sim picks this file before any system one).
+ *          Registers are plain variables (sim_sfr.h), interrupt functions become ordinary
+ *          functions the bench can call, and the XC8 delay built-ins add their length to
+ *          simCycles instead of waiting, so a bench can report the cycles a routine blocks for.
+ *          SLEEP() calls simOnSleep if set, which is where a bench advances the timebase.
+ *          The registers are declared extern here and defined once in sim.c, so every module
+ *          of a project linked into a bench sees the same registers.
+ */
+
+#ifndef SIM_XC_H
+#define SIM_XC_H
+
+#ifdef __XC8
+#error "Projects/sim/xc.h is the host shim, build for the target with the real XC8 headers"
+#endif
+
+//=============================================================================
+// SIMULATION STATE
+//=============================================================================
+#ifdef SIM_DEFINE
+#define SIM_EXTERN                  // sim.c: the one definition of each register
+#else
+#define SIM_EXTERN                  extern
+#endif
+
+SIM_EXTERN unsigned long simCycles;        // Instruction cycles spent in XC8 delay built-ins
+SIM_EXTERN void (*simOnSleep)(void);       // Called by SLEEP(), e.g. to run the tick interrupt
+
+#define SIM_SFR(name)               SIM_EXTERN volatile unsigned char name;
+#define SIM_SFR_BITS(name, fields)  SIM_EXTERN volatile union { unsigned char reg; struct { fields } bits; } sim_##name;
+
+#include "sim_sfr.h"
+
+//=============================================================================
+// COMPILER BUILT-INS
+//=============================================================================
+#define __interrupt(...)            // Interrupt functions are plain functions on the host
+#define __at(address)
+#define __eeprom
+#define asm(text)
+
+#define _delay(cycles)              (simCycles += (unsigned long)(cycles))
+#define __delay_us(us)              (simCycles += (unsigned long)(us) * (_XTAL_FREQ / 4000UL) / 1000UL)
+#define __delay_ms(ms)              (simCycles += (unsigned long)(ms) * (_XTAL_FREQ / 4000UL))
+
+#define NOP()                       ((void)0)
+#define CLRWDT()                    ((void)0)
+#define SLEEP()                     do { if (simOnSleep) simOnSleep(); } while (0)
+#define di()                        (INTCON0bits.GIE = 0)
+#define ei()                        (INTCON0bits.GIE = 1)
+
+typedef unsigned long __uint24;             // XC8 24-bit integer
+
+#endif /* SIM_XC_H */